@@ -7,8 +7,63 @@
 #include "DataGenerator.h"
 
 namespace AMPLE_RAND {
-    // 1. 棨ֻһΣ
-    std::mt19937_64 rng_64( std::chrono::steady_clock::now().time_since_epoch().count() );
+    namespace {
+        unsigned long long splitmix64( unsigned long long z ) {
+            z += 0x9E3779B97F4A7C15ULL;
+            z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+            z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+            return z ^ ( z >> 31 );
+        }
+
+        /**
+         * @brief Ӵ洢ھ̬⾲̬ʼ˳⣩
+         */
+        std::atomic < unsigned long long > &masterSeed() {
+            static std::atomic < unsigned long long > seed( [] {
+                if ( const char *env = std::getenv( "AMPLE_RAND_SEED" ) ) {
+                    return std::strtoull( env , nullptr , 10 );
+                }
+                return splitmix64( std::random_device{}() ^
+                                   static_cast < unsigned long long >(
+                                       std::chrono::steady_clock::now().time_since_epoch().count() ) );
+            }() );
+            return seed;
+        }
+
+        /**
+         * @brief ̵߳ĳʼӣһʹ rng_64 ֱ̣̣߳ͨ߳ʹ
+         */
+        unsigned long long threadInitialSeed() {
+            static std::atomic < unsigned long long > threadCount( 0 );
+            unsigned long long id = threadCount ++;
+            return id == 0 ? getSeed() : deriveSeedFrom( getSeed() , ~0ULL , id );
+        }
+    }
+
+    // 1. 棨ֻһΣÿ߳һݣ
+    thread_local RandomEngine rng_64( threadInitialSeed() );
+
+    void setSeed( unsigned long long seed ) {
+        masterSeed() = seed;
+        rng_64.seed( seed );
+    }
+
+    unsigned long long getSeed() {
+        return masterSeed();
+    }
+
+    unsigned long long deriveSeedFrom( unsigned long long seed , unsigned long long fileIndex ,
+                                       unsigned long long caseIndex ) {
+        return splitmix64( splitmix64( seed ^ splitmix64( fileIndex ) ) + caseIndex );
+    }
+
+    unsigned long long deriveSeed( unsigned long long fileIndex , unsigned long long caseIndex ) {
+        return deriveSeedFrom( getSeed() , fileIndex , caseIndex );
+    }
+
+    void printSeed( std::ostream &os ) {
+        os << "AMPLE_RAND_SEED=" << getSeed() << "\n";
+    }
 
     long long random( long long l , long long r , double opt ) {
         // У
@@ -19,25 +74,217 @@ namespace AMPLE_RAND {
             throw std::invalid_argument( "opt must be positive" );
         }
         // opt  1 ʱ߾ȷֲ·
+        // ʹ unsigned 
+        unsigned long long range = static_cast < unsigned long long >( r ) -
+                                   static_cast < unsigned long long >( l );
         if ( std::fabs( opt - 1.0 ) <= 1e-8 ) {
-            return std::uniform_int_distribution < long long >( l , r )( rng_64 );
+            return static_cast < long long >( static_cast < unsigned long long >( l ) +
+                                              detail::bounded_inclusive( rng_64 , range ) );
         }
         //  static ̰߳ȫ
         std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
         double x = dist( rng_64 );
         //  x = 0 ı߽磨Ȼ 0^ = 0⣩
         // x  [0, 1)y = x^(1/opt)  [0, 1)
-        double y = std::pow( x , 1.0 / opt );
-        // ʹ unsigned 
-        unsigned long long range = static_cast < unsigned long long >( r ) -
-                                   static_cast < unsigned long long >( l );
-        // ӳ䣺y * range  [0, range)  [l, r]
-        long long res = l + static_cast < long long >(
-                            static_cast < long double >( range ) * static_cast < long double >( y )
-                        );
-        // ˫߽籣
-        res = std::clamp( res , l , r );
-        return res;
+        double y = detail::pow_unit( x , 1.0 / opt );
+        // ӳ䣺y * (range + 1)  [0, range + 1)  [l, r]
+        return detail::unit_to_range( l , range , y );
+    }
+
+    namespace detail {
+        void uniform_unit_batch( double *out , std::size_t n ) {
+            // ȡ 53 λ generate_canonical ÿ
+            for ( std::size_t i = 0 ; i < n ; ++i ) {
+                out[i] = static_cast < double >( rng_64() >> 11 ) * 0x1.0p-53;
+            }
+        }
+
+        namespace {
+            // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+            // ݱ任ˣx^e = exp(e  ln x)x  [0, 1)
+            //   ln xx = m  2^km  [0.5, 2)ln m = 2atanh(s)s = (m-1)/(m+1)|s|  0.1716
+            //         atanh ȡ s^19ض < 1e-19
+            //   exp tt = nln2 + r|r|  ln2 / 2Taylor չ r^13ض < 2e-17
+            //   2^n ֱƴָλln2 ɸߵֱ֤ kln2 ȷ
+            // ͬһģͬʱʵΪ GCC/Clang ͣSSE/AVX/NEON ɱѡ񣩣
+            // β·֤볤ȡֿ鷽ʽ޹
+            // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+            constexpr double LN2_HI = 6.93147180369123816490e-01;
+            constexpr double LN2_LO = 1.90821492927058770002e-10;
+            constexpr double LOG2E = 1.44269504088896338700e+00;
+            constexpr double SQRT2 = 1.41421356237309504880e+00;
+            // 1.5  2^52ϺλΪ
+            constexpr double ROUND_MAGIC = 6755399441055744.0;
+            constexpr std::int64_t MANTISSA_MASK = 0x000FFFFFFFFFFFFFLL;
+            constexpr std::int64_t ONE_BITS = 0x3FF0000000000000LL;
+
+            inline std::int64_t bits_of( double x ) {
+                std::int64_t b;
+                std::memcpy( &b , &x , sizeof( b ) );
+                return b;
+            }
+
+            inline double double_of( std::int64_t b ) {
+                double x;
+                std::memcpy( &x , &b , sizeof( x ) );
+                return x;
+            }
+
+            inline double select( bool mask , double a , double b ) {
+                return mask ? a : b;
+            }
+
+            // ߼ƣSSE2/NEON û 64 λָ
+            inline std::int64_t shift_right( std::int64_t b , int k ) {
+                return static_cast < std::int64_t >( static_cast < std::uint64_t >( b ) >> k );
+            }
+
+#if defined( __GNUC__ )
+#define AMPLE_RAND_VECTOR_POW 1
+            // ȡĿƽ̨ԭĴȣAVX Ϊ 4  doubleSSE2/NEON Ϊ 2 
+#if defined( __AVX__ )
+            constexpr std::size_t VEC_BYTES = 32;
+#else
+            constexpr std::size_t VEC_BYTES = 16;
+#endif
+            constexpr std::size_t VEC_LANES = VEC_BYTES / sizeof( double );
+            typedef double vecd __attribute__( ( vector_size( VEC_BYTES ) ) );
+            // ȽϽͼΪӦ 64 λ
+            typedef decltype( vecd{} < vecd{} ) veci;
+
+            inline veci bits_of( vecd x ) { return reinterpret_cast < veci >( x ); }
+            inline vecd double_of( veci b ) { return reinterpret_cast < vecd >( b ); }
+
+            inline vecd select( veci mask , vecd a , vecd b ) {
+                return double_of( ( bits_of( a ) & mask ) | ( bits_of( b ) & ~mask ) );
+            }
+
+            inline veci shift_right( veci b , int k ) {
+                typedef std::uint64_t vecu __attribute__( ( vector_size( VEC_BYTES ) ) );
+                return reinterpret_cast < veci >( reinterpret_cast < vecu >( b ) >> k );
+            }
+#endif
+
+            template < typename D >
+#if defined( __GNUC__ )
+            __attribute__( ( always_inline ) )
+#endif
+            inline D pow_unit_kernel( D x , double e ) {
+                // ln x
+                const auto b = bits_of( x );
+                const auto big_exp = shift_right( b , 52 ) - 1023;
+                D m = double_of( ( b & MANTISSA_MASK ) | ONE_BITS );
+                const auto big = m > SQRT2;
+                m = select( big , m * 0.5 , m );
+                const D k = double_of( big_exp + bits_of( D{} + ROUND_MAGIC ) ) - ROUND_MAGIC +
+                            select( big , D{} + 1.0 , D{} );
+                const D s = ( m - 1.0 ) / ( m + 1.0 );
+                const D s2 = s * s;
+                D p = D{} + 1.0 / 19.0;
+                p = p * s2 + 1.0 / 17.0;
+                p = p * s2 + 1.0 / 15.0;
+                p = p * s2 + 1.0 / 13.0;
+                p = p * s2 + 1.0 / 11.0;
+                p = p * s2 + 1.0 / 9.0;
+                p = p * s2 + 1.0 / 7.0;
+                p = p * s2 + 1.0 / 5.0;
+                p = p * s2 + 1.0 / 3.0;
+                const D ln_m = 2.0 * s + 2.0 * s * s2 * p;
+                const D ln_x = k * LN2_HI + ( ln_m + k * LN2_LO );
+                // exp(t)
+                D t = e * ln_x;
+                const auto underflow = t < -708.0;
+                t = select( underflow , D{} - 708.0 , t );
+                const D shifted = t * LOG2E + ROUND_MAGIC;
+                const D n = shifted - ROUND_MAGIC;
+                const auto n_bits = bits_of( shifted ) - bits_of( D{} + ROUND_MAGIC );
+                const D r = ( t - n * LN2_HI ) - n * LN2_LO;
+                D q = D{} + 1.0 / 6227020800.0;
+                q = q * r + 1.0 / 479001600.0;
+                q = q * r + 1.0 / 39916800.0;
+                q = q * r + 1.0 / 3628800.0;
+                q = q * r + 1.0 / 362880.0;
+                q = q * r + 1.0 / 40320.0;
+                q = q * r + 1.0 / 5040.0;
+                q = q * r + 1.0 / 720.0;
+                q = q * r + 1.0 / 120.0;
+                q = q * r + 1.0 / 24.0;
+                q = q * r + 1.0 / 6.0;
+                q = q * r + 0.5;
+                q = q * r + 1.0;
+                q = q * r + 1.0;
+                const D y = q * double_of( ( n_bits + 1023 ) << 52 );
+                // x = 0  2^-1021 ʱȡ 0
+                return select( underflow | ( x <= 0.0 ) , D{} , y );
+            }
+        }
+
+        double pow_unit( double x , double e ) {
+            if ( e == 1.0 ) return x;
+            if ( e == 2.0 ) return x * x;
+            if ( e == 0.5 ) return std::sqrt( x );
+            return std::pow( x , e );
+        }
+
+        void pow_batch( double *x , std::size_t n , double e ) {
+            // ȷ·opt = 1 / 2 / 0.5 / 4 / 0.25 / 1/3
+            if ( e == 1.0 ) return;
+            if ( e == 2.0 ) {
+                for ( std::size_t i = 0 ; i < n ; ++i ) x[i] = x[i] * x[i];
+                return;
+            }
+            if ( e == 4.0 ) {
+                for ( std::size_t i = 0 ; i < n ; ++i ) {
+                    const double sq = x[i] * x[i];
+                    x[i] = sq * sq;
+                }
+                return;
+            }
+            if ( e == 3.0 ) {
+                for ( std::size_t i = 0 ; i < n ; ++i ) x[i] = x[i] * x[i] * x[i];
+                return;
+            }
+            if ( e == 0.5 ) {
+                for ( std::size_t i = 0 ; i < n ; ++i ) x[i] = std::sqrt( x[i] );
+                return;
+            }
+            if ( e == 0.25 ) {
+                for ( std::size_t i = 0 ; i < n ; ++i ) x[i] = std::sqrt( std::sqrt( x[i] ) );
+                return;
+            }
+#ifdef AMPLE_RAND_VECTOR_POW
+            std::size_t i = 0;
+            // һδ 4 ʽֵԽִ
+            constexpr std::size_t UNROLL = 4;
+            for ( ; i + VEC_LANES * UNROLL <= n ; i += VEC_LANES * UNROLL ) {
+                vecd v[UNROLL];
+                std::memcpy( v , x + i , sizeof( v ) );
+                for ( std::size_t u = 0 ; u < UNROLL ; ++u ) v[u] = pow_unit_kernel( v[u] , e );
+                std::memcpy( x + i , v , sizeof( v ) );
+            }
+            for ( ; i + VEC_LANES <= n ; i += VEC_LANES ) {
+                vecd v;
+                std::memcpy( &v , x + i , sizeof( v ) );
+                v = pow_unit_kernel( v , e );
+                std::memcpy( x + i , &v , sizeof( v ) );
+            }
+            if ( i < n ) {
+                // βͬ·
+                vecd v = {};
+                std::memcpy( &v , x + i , sizeof( double ) * ( n - i ) );
+                v = pow_unit_kernel( v , e );
+                std::memcpy( x + i , &v , sizeof( double ) * ( n - i ) );
+            }
+#else
+            for ( std::size_t i = 0 ; i < n ; ++i ) x[i] = pow_unit_kernel( x[i] , e );
+#endif
+        }
+    }
+
+    std::vector < long long > randomArray( std::size_t n , long long l , long long r , double opt ) {
+        std::vector < long long > result( n );
+        randomFill( result.begin() , result.end() , l , r , opt );
+        return result;
     }
 
     double randomDouble( double l , double r , double opt ) {
@@ -49,918 +296,2721 @@ namespace AMPLE_RAND {
         // ݱ任ֻһ pow
         // opt > 1  ƫ r
         // opt < 1  ƫ l
-        double y = std::pow( x , 1.0 / opt );
+        double y = detail::pow_unit( x , 1.0 / opt );
 
         return l + ( r - l ) * y;
     }
 
-    std::string randomString( int n , std::string chars , bool allowZero ) {
-        if ( n <= 0 || chars.empty() ) return "";
-        const int len = chars.size();
-        std::string result;
-        result.reserve( n ); // Ԥ
-        // ַ
-        if ( !allowZero && chars.find( '0' ) != std::string::npos ) {
-            std::string firstChars;
-            for ( char c : chars ) if ( c != '0' ) firstChars += c;
-            if ( firstChars.empty() ) {
-                // ȫ'0'޷ǰ
-                result += '0';
-            } else {
-                result += firstChars[random( 0 , firstChars.size() - 1 )];
-            }
-        } else {
-            result += chars[random( 0 , len - 1 )];
-        }
-        // ʣַ
-        for ( int i = 1 ; i < n ; ++i ) {
-            result += chars[random( 0 , len - 1 )];
-        }
+    std::vector < double > randomDoubleArray( std::size_t n , double l , double r , double opt ) {
+        std::vector < double > result( n );
+        randomDoubleFill( result.begin() , result.end() , l , r , opt );
         return result;
     }
 
-    std::string randomString( std::vector < std::string > chars ) {
-        int n = chars.size();
-        return chars[random( 0 , n - 1 )];
+    Alphabet::Alphabet( std::string_view chars ) : chars_( chars ) {
+        if ( chars_.empty() ) throw std::invalid_argument( "chars must not be empty" );
+        if ( chars_.size() > 65536 ) throw std::invalid_argument( "at most 65536 chars" );
+        const std::size_t k = chars_.size();
+        if ( ( k & ( k - 1 ) ) == 0 ) bits_ = __builtin_ctzll( k );
     }
 
-    std::vector < std::pair < int , int > > RANDOMTREE::random_tree( int n , int base , int root , double rho ,
-                                                                     bool vertices_rand ) {
-        /*
-        
-                             rho Ч                             
-        Щ
-           rho                        ̬                       
-        ੤
-           0.01       賓賓賓  (Σ 1)              
-           0.5        ǳ֧϶                              
-           1.0         O(log n)                   
-           2.0        Ĭֵ                              
-           5.0        ֧                                 
-           100+       賓賓賓賓賓賓  ( n-1)               
-        ة
-        */
-        if ( n <= 0 ) {
-            throw std::invalid_argument( "n must be positive" );
-        }
-        if ( root < 0 || root >= n ) {
-            throw std::invalid_argument( "root must be in range [0, n-1]" );
-        }
-        if ( rho <= 0.0 ) {
-            throw std::invalid_argument( "rho must be positive" );
-        }
-        if ( !vertices_rand && root != 0 ) {
-            throw std::invalid_argument(
-                "When vertices_rand=false, root must be 0 "
-                "to maintain parent < child ordering"
-            );
-        }
-        if ( n == 1 ) {
-            return std::vector < std::pair < int , int > >{};
+    Alphabet::Alphabet( std::string_view chars , const std::vector < double > &weights ) : chars_( chars ) {
+        if ( chars_.empty() ) throw std::invalid_argument( "chars must not be empty" );
+        if ( chars_.size() > 65536 ) throw std::invalid_argument( "at most 65536 chars" );
+        if ( weights.size() != chars_.size() ) throw std::invalid_argument( "weights size must equal chars size" );
+        double sum = 0;
+        for ( double w : weights ) {
+            if ( !( w >= 0.0 ) ) throw std::invalid_argument( "weights must be non-negative" );
+            sum += w;
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 1: ɻṹ
-        //         ڵ 0 Ϊʱڵ i ĸڵ [0, i-1] 
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        std::vector < int > base_parent( n , -1 );
-        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
-        // Ƿӽȷֲ
-        const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
-        for ( int i = 1 ; i < n ; ++i ) {
-            int p;
-            if ( is_uniform ) {
-                // ѡ񸸽ڵ
-                std::uniform_int_distribution < int > parent_dist( 0 , i - 1 );
-                p = parent_dist( rng_64 );
-            } else {
-                // ʹݱ任
-                double x = dist( rng_64 );
-                // rho Խx^(1/rho) Խӽ 1p Խӽ i-1
-                double y = std::pow( x , 1.0 / rho );
-                p = static_cast < int >( y * i );
-                p = std::clamp( p , 0 , i - 1 );
-            }
-            base_parent[i] = p;
+        if ( !( sum > 0.0 ) ) throw std::invalid_argument( "sum of weights must be positive" );
+        // Vose ʰ k / sum Ŵ󣬰Ѳ 1 ó 1 в
+        const std::size_t k = chars_.size();
+        std::vector < double > scaled( k );
+        std::vector < std::uint32_t > small , large;
+        for ( std::size_t i = 0 ; i < k ; ++i ) {
+            scaled[i] = weights[i] * static_cast < double >( k ) / sum;
+            ( scaled[i] < 1.0 ? small : large ).push_back( static_cast < std::uint32_t >( i ) );
         }
-        std::vector < int > parent( n , -1 );
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 2: ڵ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        if ( !vertices_rand ) {
-            // ңֱʹԭʼ
-            // ʣб (u, v) u  v ĸף u < v
-            parent = std::move( base_parent );
-        } else {
-            // ңŽڵţ root 
-            // : perm[ԭʼ] = ±
-            std::vector < int > perm( n );
-            std::iota( perm.begin() , perm.end() , 0 );
-            // Fisher-Yates 
-            for ( int i = n - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < int > d( 0 , i );
-                int j = d( rng_64 );
-                std::swap( perm[i] , perm[j] );
-            }
-            // ȷԭʼ 0 ӳ䵽Ŀ root
-            // ҵ perm  root λ
-            int root_pos = -1;
-            for ( int i = 0 ; i < n ; ++i ) {
-                if ( perm[i] == root ) {
-                    root_pos = i;
-                    break;
-                }
-            }
-            std::swap( perm[0] , perm[root_pos] );
-            //  perm[0] = rootԭʼ 0 ӳ䵽¸ root
-            // ӦУnew_parent[perm[i]] = perm[base_parent[i]]
-            for ( int i = 0 ; i < n ; ++i ) {
-                int new_id = perm[i];
-                if ( base_parent[i] == -1 ) {
-                    parent[new_id] = -1;
-                } else {
-                    parent[new_id] = perm[base_parent[i]];
-                }
+        prob_.assign( k , std::uint64_t( 1 ) << 32 );
+        alias_.resize( k );
+        std::iota( alias_.begin() , alias_.end() , 0u );
+        while ( !small.empty() && !large.empty() ) {
+            const std::uint32_t s = small.back() , l = large.back();
+            small.pop_back();
+            prob_[s] = static_cast < std::uint64_t >( scaled[s] * 4294967296.0 );
+            alias_[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if ( scaled[l] < 1.0 ) {
+                large.pop_back();
+                small.push_back( l );
             }
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 3: бӽڵбڽӱ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        std::vector < std::pair < int , int > > edges;
-        for ( int v = 0 ; v < n ; ++v ) {
-            int p = parent[v];
-            if ( p != -1 ) {
-                edges.emplace_back( p + base , v + base );
+        // ʣУΪ 1
+    }
+
+    char Alphabet::sample() const {
+        char c;
+        fill( &c , 1 );
+        return c;
+    }
+
+    char Alphabet::sampleNonZero() const {
+        if ( chars_.find_first_not_of( '0' ) == std::string::npos ) return '0';
+        if ( !prob_.empty() ) {
+            // ȨʱȷϷ '0' ַĸΪȫȨֵ '0' ϣ
+            bool possible = false;
+            for ( std::size_t i = 0 ; i < chars_.size() && !possible ; ++i ) {
+                possible = ( chars_[i] != '0' && prob_[i] > 0 ) ||
+                           ( chars_[alias_[i]] != '0' && prob_[i] < ( std::uint64_t( 1 ) << 32 ) );
             }
+            if ( !possible ) return '0';
         }
-        return edges;
+        char c;
+        do {
+            c = sample();
+        } while ( c == '0' );
+        return c;
     }
 
-    std::vector < int >
-    RANDOMTREE::random_tree_parent( int n , int base , int root , double rho , bool vertices_rand ) {
-        /*
-        
-                             rho Ч                             
-        Щ
-           rho                        ̬                       
-        ੤
-           0.01       賓賓賓  (Σ 1)              
-           0.5        ǳ֧϶                              
-           1.0         O(log n)                   
-           2.0        Ĭֵ                              
-           5.0        ֧                                 
-           100+       賓賓賓賓賓賓  ( n-1)               
-        ة
-        */
-        if ( n <= 0 ) {
-            throw std::invalid_argument( "n must be positive" );
-        }
-        if ( root < 0 || root >= n ) {
-            throw std::invalid_argument( "root must be in range [0, n-1]" );
-        }
-        if ( rho <= 0.0 ) {
-            throw std::invalid_argument( "rho must be positive" );
+    void Alphabet::fill( char *out , std::size_t n ) const {
+        const char *table = chars_.data();
+        const std::uint32_t k = static_cast < std::uint32_t >( chars_.size() );
+        if ( !prob_.empty() ) {
+            //  32 λ Lemire ѡУ 32 λȡַǱ
+            const std::uint32_t threshold = static_cast < std::uint32_t >( -k ) % k;
+            for ( std::size_t i = 0 ; i < n ; ) {
+                const std::uint64_t x = rng_64();
+                const std::uint64_t col = static_cast < std::uint64_t >( static_cast < std::uint32_t >( x ) ) * k;
+                if ( static_cast < std::uint32_t >( col ) < threshold ) continue;
+                const std::uint32_t j = static_cast < std::uint32_t >( col >> 32 );
+                out[i++] = table[( x >> 32 ) < prob_[j] ? j : alias_[j]];
+            }
+            return;
         }
-        if ( !vertices_rand && root != 0 ) {
-            throw std::invalid_argument(
-                "When vertices_rand=false, root must be 0 "
-                "to maintain parent < child ordering"
-            );
+        if ( bits_ == 0 ) {
+            std::memset( out , table[0] , n );
+            return;
         }
-        if ( n == 1 ) {
-            return std::vector < int >( n , -1 );
+        if ( bits_ > 0 ) {
+            // 2 ݣÿг 64 / bits_ Σ޾ܾ
+            const int per = 64 / bits_;
+            const std::uint64_t mask = ( std::uint64_t( 1 ) << bits_ ) - 1;
+            std::size_t i = 0;
+            for ( ; i + per <= n ; i += per ) {
+                std::uint64_t x = rng_64();
+                for ( int t = 0 ; t < per ; ++t , x >>= bits_ ) out[i + t] = table[x & mask];
+            }
+            for ( std::uint64_t x = rng_64() ; i < n ; ++i , x >>= bits_ ) out[i] = table[x & mask];
+            return;
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 1: ɻṹ
-        //         ڵ 0 Ϊʱڵ i ĸڵ [0, i-1] 
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        std::vector < int > base_parent( n , -1 );
-        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
-        // Ƿӽȷֲ
-        const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
-        for ( int i = 1 ; i < n ; ++i ) {
-            int p;
-            if ( is_uniform ) {
-                // ѡ񸸽ڵ
-                std::uniform_int_distribution < int > parent_dist( 0 , i - 1 );
-                p = parent_dist( rng_64 );
-            } else {
-                // ʹݱ任
-                double x = dist( rng_64 );
-                // rho Խx^(1/rho) Խӽ 1p Խӽ i-1
-                double y = std::pow( x , 1.0 / rho );
-                p = static_cast < int >( y * i );
-                p = std::clamp( p , 0 , i - 1 );
+        // 16 λ Lemirexk ĸ 16 λΪ±꣬ 16 λ [0, 2^16 mod k) ʱܾ
+        const std::uint32_t threshold = ( 65536u - k ) % k;
+        std::size_t i = 0;
+        while ( i < n ) {
+            std::uint64_t x = rng_64();
+            for ( int t = 0 ; t < 4 && i < n ; ++t , x >>= 16 ) {
+                const std::uint32_t y = static_cast < std::uint32_t >( x & 0xFFFF ) * k;
+                out[i] = table[y >> 16];
+                // ޷֧ܾʱǰһθͬһλ
+                i += ( y & 0xFFFF ) >= threshold;
             }
-            base_parent[i] = p;
         }
-        std::vector < int > parent( n , -1 );
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 2: ڵ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        if ( !vertices_rand ) {
-            // ңֱʹԭʼ
-            // ʣб (u, v) u  v ĸף u < v
-            parent = std::move( base_parent );
+    }
+
+    std::string Alphabet::generate( std::size_t n , bool allowZero ) const {
+        std::string result( n , '\0' );
+        if ( n == 0 ) return result;
+        if ( allowZero || chars_.find( '0' ) == std::string::npos ) {
+            fill( result.data() , n );
         } else {
-            // ңŽڵţ root 
-            // : perm[ԭʼ] = ±
-            std::vector < int > perm( n );
-            std::iota( perm.begin() , perm.end() , 0 );
-            // Fisher-Yates 
-            for ( int i = n - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < int > d( 0 , i );
-                int j = d( rng_64 );
-                std::swap( perm[i] , perm[j] );
-            }
-            // ȷԭʼ 0 ӳ䵽Ŀ root
-            // ҵ perm  root λ
-            int root_pos = -1;
-            for ( int i = 0 ; i < n ; ++i ) {
-                if ( perm[i] == root ) {
-                    root_pos = i;
-                    break;
-                }
-            }
-            std::swap( perm[0] , perm[root_pos] );
-            //  perm[0] = rootԭʼ 0 ӳ䵽¸ root
-            // ӦУnew_parent[perm[i]] = perm[base_parent[i]]
-            for ( int i = 0 ; i < n ; ++i ) {
-                int new_id = perm[i];
-                if ( base_parent[i] == -1 ) {
-                    parent[new_id] = -1;
-                } else {
-                    parent[new_id] = perm[base_parent[i]];
-                }
-            }
-            for ( auto &p : parent ) {
-                if ( p == -1 ) continue;
-                p += base;
-            }
+            result[0] = sampleNonZero();
+            fill( result.data() + 1 , n - 1 );
         }
-        return parent;
+        return result;
     }
 
-    std::vector < std::pair < int , int > > RANDOMTREE::random_tree_chain(
-        int n , int base , int root , bool vertices_rand ) {
-        return random_tree( n , base , root , 1e9 , vertices_rand );
+    std::string randomString( int n , const std::string &chars , bool allowZero ) {
+        if ( n <= 0 || chars.empty() ) return "";
+        return Alphabet( chars ).generate( static_cast < std::size_t >( n ) , allowZero );
     }
 
-    std::vector < std::pair < int , int > > RANDOMTREE::random_tree_star(
-        int n , int base , int root , bool vertices_rand ) {
-        return random_tree( n , base , root , 1e-9 , vertices_rand );
+    std::string randomString( const std::vector < std::string > &chars ) {
+        return chars[detail::bounded( rng_64 , chars.size() )];
     }
 
-    std::vector < std::pair < int , int > > RANDOMTREE::random_binary_tree(
-        int n , int base , int root , double rho , bool vertices_rand , int balance ) {
-        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
-        if ( root < 0 || root >= n ) throw std::invalid_argument( "root out of range" );
-        if ( rho <= 0.0 ) throw std::invalid_argument( "rho must be positive" );
-        if ( balance < 0.0 || balance > 1.0 ) throw std::invalid_argument( "balance must be in [0, 1]" );
-        if ( !vertices_rand && root != 0 ) {
-            throw std::invalid_argument( "root must be 0 when vertices_rand=false" );
-        }
+    namespace {
+        /**
+         * @brief 64 λ±ȥؼ
+         * @details ȫСʱλͼڹϣʹλͼʹ̽ĿѰַϣ
+         *          ϣԤƲ 1.5 ȡ 2 ݣܳ expected
+         */
+        class IndexSet {
+            public:
+                IndexSet( std::uint64_t universe , std::uint64_t expected ) {
+                    std::uint64_t capacity = 16;
+                    shift = 60;
+                    while ( capacity < expected + expected / 2 ) {
+                        capacity <<= 1;
+                        --shift;
+                    }
+                    useBits = universe / 8 <= capacity * sizeof( std::uint64_t );
+                    if ( useBits ) {
+                        bits.assign( ( universe + 63 ) / 64 , 0 );
+                    } else {
+                        table.assign( capacity , EMPTY );
+                        mask = capacity - 1;
+                    }
+                }
 
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // λslot = (ڵ, ǷΪλ, )
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        struct Slot {
-            int node;
-            bool is_left;
-            int depth;
+                /**
+                 * @brief ±
+                 * @return ǷΪ±
+                 */
+                bool insert( std::uint64_t key ) {
+                    if ( useBits ) {
+                        std::uint64_t &word = bits[key >> 6];
+                        const std::uint64_t bit = std::uint64_t( 1 ) << ( key & 63 );
+                        if ( word & bit ) return false;
+                        word |= bit;
+                        return true;
+                    }
+                    for ( std::uint64_t i = hash( key ) ; ; i = ( i + 1 ) & mask ) {
+                        if ( table[i] == key ) return false;
+                        if ( table[i] == EMPTY ) {
+                            table[i] = key;
+                            return true;
+                        }
+                    }
+                }
+
+                /**
+                 * @brief  [0, universe) вڼڵ±꣨λͼģʽ
+                 */
+                template < typename Func > void for_each_absent( std::uint64_t universe , Func &&f ) const {
+                    for ( std::uint64_t w = 0 ; w < bits.size() ; ++w ) {
+                        std::uint64_t free = ~bits[w];
+                        while ( free ) {
+                            const std::uint64_t key = ( w << 6 ) + static_cast < std::uint64_t >( __builtin_ctzll( free ) );
+                            if ( key >= universe ) return;
+                            f( key );
+                            free &= free - 1;
+                        }
+                    }
+                }
+
+            private:
+                static constexpr std::uint64_t EMPTY = ~std::uint64_t( 0 );
+                bool useBits;
+                std::vector < std::uint64_t > bits;
+                std::vector < std::uint64_t > table;
+                std::uint64_t mask = 0;
+                int shift = 0;
+
+                std::uint64_t hash( std::uint64_t key ) const {
+                    // Fibonacci ˷ɢУȡ˻ log2(capacity) λ
+                    return ( key * 0x9E3779B97F4A7C15ULL ) >> shift;
+                }
         };
-        std::vector < int > parent( n , -1 );
-        std::vector < std::pair < int , int > > edges;
-        std::vector < Slot > available_slots;
-        std::vector < int > base_parent( n , -1 );
-        std::vector < int > base_left( n , -1 );
-        std::vector < int > base_right( n , -1 );
-        std::vector < int > node_depth( n , 0 );
-        // ڵòλ
-        available_slots.push_back( { 0 , true , 1 } ); // λ
-        available_slots.push_back( { 0 , false , 1 } ); // Ҳλ
-        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
-        const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
-        for ( int i = 1 ; i < n ; ++i ) {
-            // 
-            // Step 1: ѡһλ
-            // 
-            int slot_idx;
-            int num_slots = available_slots.size();
-
-            if ( is_uniform ) {
-                std::uniform_int_distribution < int > slot_dist( 0 , num_slots - 1 );
-                slot_idx = slot_dist( rng_64 );
-            } else {
-                // rho ԽԽѡĲλ
-                // ʹü򻯵ķȰȷ飬 rho ѡĸ
-                double x = dist( rng_64 );
-                double y = std::pow( x , 1.0 / rho );
-                slot_idx = static_cast < int >( y * num_slots );
-                slot_idx = std::clamp( slot_idx , 0 , num_slots - 1 );
 
-                // λǳ  
-                std::sort( available_slots.begin() , available_slots.end() ,
-                           []( const Slot &a , const Slot &b ) { return a.depth < b.depth; } );
+        /**
+         * @brief  (u, v) ± [0, size()) ֮˫
+         * @details u * n + vԻʱ v = u
+         *          򣺰 v еαţu < vԻʱ u <= v
+         */
+        struct PairSpace {
+            int n;
+            bool directional;
+            bool self_rings;
+
+            std::uint64_t size() const {
+                const std::uint64_t N = static_cast < std::uint64_t >( n );
+                if ( directional ) return self_rings ? N * N : N * ( N - 1 );
+                return self_rings ? N * ( N + 1 ) / 2 : N * ( N - 1 ) / 2;
             }
 
-            Slot selected = available_slots[slot_idx];
-
-            // ӿòλƳ
-            available_slots.erase( available_slots.begin() + slot_idx );
+            std::uint64_t encode( int u , int v ) const {
+                const std::uint64_t U = static_cast < std::uint64_t >( u ) , V = static_cast < std::uint64_t >( v );
+                if ( directional ) {
+                    if ( self_rings ) return U * n + V;
+                    return U * ( n - 1 ) + ( V < U ? V : V - 1 );
+                }
+                const std::uint64_t lo = std::min( U , V ) , hi = std::max( U , V );
+                return self_rings ? hi * ( hi + 1 ) / 2 + lo : hi * ( hi - 1 ) / 2 + lo;
+            }
 
-            // 
-            // Step 2: ½ڵ뵽ѡеĲλ
-            // 
-            int parent_node = selected.node;
-            base_parent[i] = parent_node;
-            node_depth[i] = selected.depth;
+            std::pair < int , int > decode( std::uint64_t idx ) const {
+                if ( directional ) {
+                    if ( self_rings ) return { static_cast < int >( idx / n ) , static_cast < int >( idx % n ) };
+                    const std::uint64_t u = idx / ( n - 1 ) , v = idx % ( n - 1 );
+                    return { static_cast < int >( u ) , static_cast < int >( v < u ? v : v + 1 ) };
+                }
+                //  hi  row(hi) = hi(hi-1)/2Իʱ hi(hi+1)/2ø
+                const std::uint64_t shift = self_rings ? 1 : 0;
+                auto row = [&]( std::uint64_t h ) {
+                    return ( h + shift ) * ( h + shift - 1 ) / 2;
+                };
+                std::uint64_t hi = static_cast < std::uint64_t >(
+                    ( 1.0 + std::sqrt( 1.0 + 8.0 * static_cast < double >( idx ) ) ) / 2.0 );
+                hi = hi >= shift ? hi - shift : 0;
+                while ( hi > 0 && row( hi ) > idx ) --hi;
+                while ( row( hi + 1 ) <= idx ) ++hi;
+                return { static_cast < int >( idx - row( hi ) ) , static_cast < int >( hi ) };
+            }
+        };
 
-            if ( selected.is_left ) {
-                base_left[parent_node] = i;
-            } else {
-                base_right[parent_node] = i;
-            }
-            // 
-            // Step 3: ½ڵĲλ
-            // 
-            //  balance λ˳
-            if ( dist( rng_64 ) < 0.5 ) {
-                available_slots.push_back( { i , true , node_depth[i] + 1 } );
-                available_slots.push_back( { i , false , node_depth[i] + 1 } );
+        /**
+         * @brief  [0, total) ȥ taken ȳȡ count ͬ±꣬ν emit
+         * @param total ±ռС
+         * @param taken ռõ±꣨ͬ
+         * @param count ȡ total - taken.size()
+         * @param emit صΪе±
+         *
+         * @details ϡ裨2 (|taken| + count) <= totalʱܾ + IndexSet 2 /
+         *          ʱȫ 2 (|taken| + count)ʹλͼcount ±һų
+         *          ʣ±ꡣڴ O(|taken| + count)
+         */
+        template < typename Emit >
+        void sampleDistinctIndices( std::uint64_t total , const std::vector < std::uint64_t > &taken ,
+                                    std::uint64_t count , Emit &&emit ) {
+            const std::uint64_t used = taken.size();
+            if ( count == 0 ) return;
+            const bool sparse = 2 * ( used + count ) <= total;
+            IndexSet seen( total , sparse ? used + count : total );
+            for ( std::uint64_t idx : taken ) seen.insert( idx );
+            const std::uint64_t free = total - used;
+            if ( sparse || 2 * count <= free ) {
+                while ( count > 0 ) {
+                    const std::uint64_t idx = detail::bounded( rng_64 , total );
+                    if ( seen.insert( idx ) ) {
+                        emit( idx );
+                        --count;
+                    }
+                }
             } else {
-                available_slots.push_back( { i , false , node_depth[i] + 1 } );
-                available_slots.push_back( { i , true , node_depth[i] + 1 } );
+                // ȡų free - count ȫѡ
+                for ( std::uint64_t excluded = free - count ; excluded > 0 ; ) {
+                    if ( seen.insert( detail::bounded( rng_64 , total ) ) ) --excluded;
+                }
+                seen.for_each_absent( total , emit );
             }
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // ڵŴ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        if ( !vertices_rand ) {
-            parent = std::move( base_parent );
-        } else {
-            std::vector < int > perm( n );
-            std::iota( perm.begin() , perm.end() , 0 );
-            for ( int i = n - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < int > d( 0 , i );
-                std::swap( perm[i] , perm[d( rng_64 )] );
-            }
-            // ȷԭʼ 0 ӳ䵽Ŀ root
-            int root_pos = std::find( perm.begin() , perm.end() , root ) - perm.begin();
-            std::swap( perm[0] , perm[root_pos] );
+    }
 
-            // perm[old_id] = new_id
-            // Ҫӳ䣺inv_perm[new_id] = old_id
-            std::vector < int > inv_perm( n );
-            for ( int i = 0 ; i < n ; ++i ) inv_perm[perm[i]] = i;
+    namespace {
+        // ǰ̵߳Ĳд߳0 ʾӲ߳
+        thread_local unsigned shuffleThreadCount = 0;
+    }
 
-            auto map_id = [&]( int old_id ) ->int {
-                return old_id == -1 ? -1 : perm[old_id];
-            };
+    void setShuffleThreads( unsigned threads ) {
+        shuffleThreadCount = threads;
+    }
 
-            for ( int old_id = 0 ; old_id < n ; ++old_id ) {
-                int new_id = perm[old_id];
-                parent[new_id] = map_id( base_parent[old_id] );
-            }
-        }
-        // б
-        for ( int v = 0 ; v < n ; ++v ) {
-            if ( parent[v] != -1 ) {
-                int p = parent[v];
-                edges.emplace_back( p + base , v + base );
-            }
+    unsigned getShuffleThreads() {
+        return shuffleThreadCount;
+    }
+
+    std::vector < int > randomPermutation( int n , int base , unsigned threads ) {
+        if ( n < 0 ) throw std::invalid_argument( "n must be non-negative" );
+        if ( threads == 0 ) threads = shuffleThreadCount;
+        std::vector < int > perm( n );
+        const std::size_t size = perm.size();
+        if ( size < detail::PARALLEL_SHUFFLE_THRESHOLD ) {
+            std::iota( perm.begin() , perm.end() , base );
+            RandomBasic.shuffle( perm );
+        } else {
+            detail::scatterShuffle( perm.data() , size , [base]( std::size_t i ) {
+                return static_cast < int >( i ) + base;
+            } , rng_64() , threads );
         }
-        return edges;
+        return perm;
     }
 
-    std::vector < std::pair < int , int > > RANDOMTREE::random_forest_tree(
-        int n , int num_trees , int base , double rho , bool vertices_rand , double size_variance ) {
-        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
-        if ( num_trees <= 0 ) throw std::invalid_argument( "num_trees must be positive" );
-        if ( num_trees > n ) throw std::invalid_argument( "num_trees cannot exceed n" );
-        if ( rho <= 0.0 ) throw std::invalid_argument( "rho must be positive" );
-        if ( size_variance < 0.0 || size_variance > 1.0 ) {
-            throw std::invalid_argument( "size_variance must be in [0, 1]" );
+    namespace {
+        /**
+         * @brief [l, r] ĳ r - l + 1
+         */
+        std::uint64_t rangeSize( std::size_t k , long long l , long long r ) {
+            if ( l > r ) throw std::invalid_argument( "l must not exceed r" );
+            const std::uint64_t total = static_cast < std::uint64_t >( r ) - static_cast < std::uint64_t >( l ) + 1;
+            if ( total == 0 ) throw std::invalid_argument( "range [l, r] too large" );
+            if ( k > total ) throw std::invalid_argument( "k must not exceed r - l + 1" );
+            return total;
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 1: ÿĴС
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        std::vector < int > tree_sizes( num_trees , 1 ); // ÿ 1 ڵ
-        int remaining = n - num_trees;
-
-        if ( remaining > 0 ) {
-            if ( size_variance < 1e-9 ) {
-                // ȷ
-                int base = remaining / num_trees;
-                int extra = remaining % num_trees;
-                for ( int i = 0 ; i < num_trees ; ++i ) {
-                    tree_sizes[i] += base + ( i < extra ? 1 : 0 );
+
+        long long offsetValue( long long l , std::uint64_t idx ) {
+            return static_cast < long long >( static_cast < std::uint64_t >( l ) + idx );
+        }
+
+        /**
+         * @brief Ԫܳɿ齻 sinkValueChunkSink / EdgeChunkSink / CharChunkSink stream_ ϵй
+         * @param shuffle_chunks ǰǷҿ˳ͼʽ汾ʹã
+         */
+        template < typename T > class Chunker {
+            public:
+                using Sink = std::function < void( const T * , std::size_t ) >;
+
+                Chunker( const Sink &sink , std::size_t chunk_size , bool shuffle_chunks = false )
+                    : sink( sink ) , chunk_size( std::max < std::size_t >( chunk_size , 1 ) ) ,
+                      shuffle_chunks( shuffle_chunks ) {
                 }
-            } else {
-                // 
-                std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
-                std::vector < double > weights( num_trees );
-                double sum = 0;
-
-                for ( int i = 0 ; i < num_trees ; ++i ) {
-                    // Ͼȷ
-                    double uniform_part = 1.0 / num_trees;
-                    double random_part = dist( rng_64 );
-                    weights[i] = ( 1.0 - size_variance ) * uniform_part + size_variance * random_part;
-                    sum += weights[i];
+
+                template < typename... Args > void push( Args &&... args ) {
+                    buffer.emplace_back( std::forward < Args >( args )... );
+                    if ( buffer.size() >= chunk_size ) flush();
                 }
 
-                // һ
-                for ( int i = 0 ; i < num_trees ; ++i ) {
-                    int alloc = static_cast < int >( weights[i] / sum * remaining );
-                    tree_sizes[i] += alloc;
+                /**
+                 * @brief ׷ n Ԫأgen(out, count) ֱд뻺н count λ
+                 */
+                template < typename Gen > void append( std::size_t n , Gen &&gen ) {
+                    while ( n > 0 ) {
+                        const std::size_t used = buffer.size();
+                        const std::size_t count = std::min( n , chunk_size - used );
+                        buffer.resize( used + count );
+                        gen( buffer.data() + used , count );
+                        n -= count;
+                        if ( buffer.size() >= chunk_size ) flush();
+                    }
                 }
 
-                // 
-                int allocated = 0;
-                for ( int i = 0 ; i < num_trees ; ++i ) allocated += tree_sizes[i];
-                int diff = n - allocated;
+                void flush() {
+                    if ( buffer.empty() ) return;
+                    if ( shuffle_chunks ) RandomBasic.shuffle( buffer );
+                    sink( buffer.data() , buffer.size() );
+                    buffer.clear();
+                }
+
+            private:
+                const Sink &sink;
+                std::size_t chunk_size;
+                bool shuffle_chunks;
+                std::vector < T > buffer;
+        };
+
+        // (0, 1] ϵľʵȡʹ
+        double openUnit() {
+            return static_cast < double >( ( rng_64() >> 11 ) + 1 ) * 0x1.0p-53;
+        }
+
+        // [0, 1) ϵľʵ
+        double closedUnit() {
+            return static_cast < double >( rng_64() >> 11 ) * 0x1.0p-53;
+        }
 
-                for ( int i = 0 ; diff > 0 && i < num_trees ; ++i, --diff ) {
-                    ++tree_sizes[i];
+        /**
+         * @brief Vitter Method A [0, N) аȡ n ±꣨O(N) ʱ䣬ֻ N <= 13n ʱʹã
+         * @param start ±ƫ
+         */
+        template < typename Emit > void sampleMethodA( std::uint64_t N , std::uint64_t n , std::uint64_t start ,
+                                                       Emit &&emit ) {
+            double top = static_cast < double >( N - n ) , Nreal = static_cast < double >( N );
+            std::uint64_t pos = start;
+            for ( ; n >= 2 ; --n ) {
+                const double V = closedUnit();
+                std::uint64_t S = 0;
+                // P(S >= s + 1) = P(S >= s)(top - s) / (Nreal - s)
+                for ( double quot = top / Nreal ; quot > V ; quot = quot * top / Nreal ) {
+                    ++S;
+                    --top;
+                    --Nreal;
                 }
+                pos += S;
+                emit( pos++ );
+                --Nreal;
+            }
+            if ( n == 1 ) {
+                const auto S = static_cast < std::uint64_t >( Nreal * closedUnit() );
+                emit( pos + std::min( S , static_cast < std::uint64_t >( Nreal ) - 1 ) );
             }
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 2: ΪÿڵŷΧ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        std::vector < int > tree_start( num_trees );
-        tree_start[0] = 0;
-        for ( int i = 1 ; i < num_trees ; ++i ) {
-            tree_start[i] = tree_start[i - 1] + tree_sizes[i - 1];
+
+        /**
+         * @brief Vitter Method D [0, N) аȡ n ±꣬ O(n) ʱ䡢O(1) ڴ
+         * @details  S±ֲ N(1 - V^(1/n)) Ϊܾ
+         *          ɼѹֱӽܣʣѡ 1/13 ʱ Method AN <= 2^53
+         */
+        template < typename Emit > void sampleMethodD( std::uint64_t N , std::uint64_t n , Emit &&emit ) {
+            constexpr std::uint64_t ALPHA_INV = 13;
+            std::uint64_t pos = 0;
+            if ( n == 0 ) return;
+            double nreal = static_cast < double >( n ) , Nreal = static_cast < double >( N );
+            double ninv = 1.0 / nreal;
+            double Vprime = std::exp( std::log( openUnit() ) * ninv );
+            std::uint64_t qu1 = N - n + 1;
+            double qu1real = Nreal - nreal + 1.0;
+            while ( n > 1 && ALPHA_INV * n < N ) {
+                const double nmin1inv = 1.0 / ( nreal - 1.0 );
+                std::uint64_t S;
+                double X;
+                while ( true ) {
+                    // 磺X = N(1 - V')Ҫ S < qu1
+                    while ( true ) {
+                        X = Nreal * ( 1.0 - Vprime );
+                        S = static_cast < std::uint64_t >( X );
+                        if ( S < qu1 ) break;
+                        Vprime = std::exp( std::log( openUnit() ) * ninv );
+                    }
+                    const double U = openUnit();
+                    const double negSreal = -static_cast < double >( S );
+                    const double y1 = std::exp( std::log( U * Nreal / qu1real ) * nmin1inv );
+                    Vprime = y1 * ( 1.0 - X / Nreal ) * ( qu1real / ( negSreal + qu1real ) );
+                    // ѹ
+                    if ( Vprime <= 1.0 ) break;
+                    // ȷԣy2 =  (N-1-t) / (N-n-t) ıֵ
+                    double y2 = 1.0 , top = Nreal - 1.0 , bottom;
+                    std::uint64_t limit;
+                    if ( n - 1 > S ) {
+                        bottom = Nreal - nreal;
+                        limit = N - S;
+                    } else {
+                        bottom = negSreal + Nreal - 1.0;
+                        limit = qu1;
+                    }
+                    for ( std::uint64_t t = N - 1 ; t >= limit ; --t ) {
+                        y2 = y2 * top / bottom;
+                        --top;
+                        --bottom;
+                    }
+                    if ( Nreal / ( Nreal - X ) >= y1 * std::exp( std::log( y2 ) * nmin1inv ) ) {
+                        Vprime = std::exp( std::log( openUnit() ) * nmin1inv );
+                        break;
+                    }
+                    Vprime = std::exp( std::log( openUnit() ) * ninv );
+                }
+                pos += S;
+                emit( pos++ );
+                N -= S + 1;
+                Nreal = static_cast < double >( N );
+                --n;
+                nreal -= 1.0;
+                ninv = nmin1inv;
+                qu1 -= S;
+                qu1real -= static_cast < double >( S );
+            }
+            if ( n > 1 ) {
+                sampleMethodA( N , n , pos , emit );
+            } else {
+                const auto S = static_cast < std::uint64_t >( Nreal * Vprime );
+                emit( pos + std::min( S , N - 1 ) );
+            }
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 3: ÿ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
-        const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
-        std::vector < int > roots( num_trees );
-        std::vector < int > tree_id( n );
-        std::vector < int > parent( n , -1 );
-        std::vector < std::pair < int , int > > edges;
-        for ( int t = 0 ; t < num_trees ; ++t ) {
-            int start = tree_start[t];
-            int sz = tree_sizes[t];
-            roots[t] = start;
-            tree_id[start] = t;
-            parent[start] = -1;
-            for ( int i = 1 ; i < sz ; ++i ) {
-                int node = start + i;
-                tree_id[node] = t;
+
+        /**
+         * @brief  [0, total) аȡ count ͬ±
+         */
+        template < typename Emit > void sampleSortedIndices( std::uint64_t total , std::uint64_t count ,
+                                                             Emit &&emit ) {
+            if ( total <= ( std::uint64_t( 1 ) << 53 ) ) {
+                sampleMethodD( total , count , emit );
+                return;
+            }
+            std::vector < std::uint64_t > picked;
+            picked.reserve( count );
+            sampleDistinctIndices( total , {} , count , [&]( std::uint64_t idx ) {
+                picked.push_back( idx );
+            } );
+            std::sort( picked.begin() , picked.end() );
+            for ( std::uint64_t idx : picked ) emit( idx );
+        }
+    }
+
+    std::vector < long long > randomDistinct( std::size_t k , long long l , long long r ) {
+        const std::uint64_t total = rangeSize( k , l , r );
+        std::vector < long long > result;
+        result.reserve( k );
+        sampleDistinctIndices( total , {} , k , [&]( std::uint64_t idx ) {
+            result.push_back( offsetValue( l , idx ) );
+        } );
+        // ȡʱͳһٴһ
+        RandomBasic.shuffle( result );
+        return result;
+    }
+
+    void streamDistinct( std::size_t k , long long l , long long r , const ValueChunkSink &sink ,
+                         std::size_t chunk_size ) {
+        const std::uint64_t total = rangeSize( k , l , r );
+        Chunker < long long > out( sink , chunk_size );
+        if ( 2 * static_cast < std::uint64_t >( k ) <= total ) {
+            // ܾ鵽˳
+            sampleDistinctIndices( total , {} , k , [&]( std::uint64_t idx ) {
+                out.push( offsetValue( l , idx ) );
+            } );
+        } else {
+            // ʱȫ 2kռٴ
+            for ( long long x : randomDistinct( k , l , r ) ) out.push( x );
+        }
+        out.flush();
+    }
+
+    std::vector < long long > randomSortedSample( std::size_t k , long long l , long long r ) {
+        const std::uint64_t total = rangeSize( k , l , r );
+        std::vector < long long > result;
+        result.reserve( k );
+        sampleSortedIndices( total , k , [&]( std::uint64_t idx ) {
+            result.push_back( offsetValue( l , idx ) );
+        } );
+        return result;
+    }
+
+    void streamSortedSample( std::size_t k , long long l , long long r , const ValueChunkSink &sink ,
+                             std::size_t chunk_size ) {
+        const std::uint64_t total = rangeSize( k , l , r );
+        Chunker < long long > out( sink , chunk_size );
+        sampleSortedIndices( total , k , [&]( std::uint64_t idx ) {
+            out.push( offsetValue( l , idx ) );
+        } );
+        out.flush();
+    }
+
+    namespace {
+        /**
+         * @brief 巨 total ز k (>= 1) Ǹ֮ͣtotal + k - 1 < 2^64
+         */
+        std::vector < std::uint64_t > weakComposition( std::uint64_t total , std::size_t k ) {
+            std::vector < std::uint64_t > parts( k );
+            //  total + k - 1 λаѡ k - 1 壬ڸ֮λִС
+            std::uint64_t prev = 0;
+            std::size_t i = 0;
+            sampleSortedIndices( total + k - 1 , k - 1 , [&]( std::uint64_t bar ) {
+                parts[i++] = bar - prev;
+                prev = bar + 1;
+            } );
+            parts[k - 1] = total + k - 1 - prev;
+            return parts;
+        }
+
+        /**
+         * @brief  total ز cap.size() Ǹ֮ͣ i  cap[i]Ҫ  cap >= total
+         * @details  total λ  cap - total нСһ巨ܾԽĽ
+         *          ʧʱԽ粿ֽضϣ·ָδĲֱ֣
+         */
+        std::vector < std::uint64_t > cappedComposition( std::uint64_t total , const std::vector < std::uint64_t > &cap ) {
+            constexpr int MAX_ATTEMPTS = 16;
+            const std::size_t k = cap.size();
+            if ( *std::min_element( cap.begin() , cap.end() ) >= total ) return weakComposition( total , k );
+            // λһࣺy[i] = cap[i] - x[i] ͬǴϽ cap[i] ľ
+            std::uint64_t cap_sum = 0;
+            for ( std::uint64_t c : cap ) cap_sum = c > ~cap_sum ? ~std::uint64_t( 0 ) : cap_sum + c;
+            const std::uint64_t room = cap_sum - total;
+            const bool flip = room < total;
+            const std::uint64_t target = flip ? room : total;
+            auto finish = [&]( std::vector < std::uint64_t > &w ) {
+                if ( flip ) {
+                    for ( std::size_t i = 0 ; i < k ; ++i ) w[i] = cap[i] - w[i];
+                }
+                return std::move( w );
+            };
+            std::vector < std::uint64_t > w;
+            for ( int attempt = 0 ; attempt < MAX_ATTEMPTS ; ++attempt ) {
+                w = weakComposition( target , k );
+                bool ok = true;
+                for ( std::size_t i = 0 ; i < k && ok ; ++i ) ok = w[i] <= cap[i];
+                if ( ok ) return finish( w );
+            }
+            // ضϲ·䣬ÿһֱ
+            std::vector < std::size_t > open( k );
+            std::iota( open.begin() , open.end() , std::size_t( 0 ) );
+            while ( true ) {
+                std::uint64_t excess = 0;
+                std::size_t kept = 0;
+                for ( std::size_t i : open ) {
+                    if ( w[i] >= cap[i] ) {
+                        excess += w[i] - cap[i];
+                        w[i] = cap[i];
+                    } else {
+                        open[kept++] = i;
+                    }
+                }
+                open.resize( kept );
+                if ( excess == 0 ) break;
+                const std::vector < std::uint64_t > extra = weakComposition( excess , open.size() );
+                for ( std::size_t j = 0 ; j < open.size() ; ++j ) w[open[j]] += extra[j];
+            }
+            return finish( w );
+        }
+    }
+
+    std::vector < long long > randomComposition( long long total , std::size_t k , long long min_part ,
+                                                 long long max_part , double variance ) {
+        if ( min_part > max_part ) throw std::invalid_argument( "min_part must not exceed max_part" );
+        if ( !( variance >= 0.0 && variance <= 1.0 ) ) throw std::invalid_argument( "variance must be in [0, 1]" );
+        if ( k == 0 ) {
+            if ( total != 0 ) throw std::invalid_argument( "total must be 0 when k is 0" );
+            return {};
+        }
+        const __int128 low = static_cast < __int128 >( k ) * min_part;
+        const __int128 high = static_cast < __int128 >( k ) * max_part;
+        if ( total < low || total > high ) {
+            throw std::invalid_argument( "total must be in [k * min_part, k * max_part]" );
+        }
+        // ۳½ÿֵ
+        const __int128 slack_wide = static_cast < __int128 >( total ) - low;
+        if ( slack_wide + static_cast < __int128 >( k ) > static_cast < __int128 >( ~std::uint64_t( 0 ) ) ) {
+            throw std::invalid_argument( "total - k * min_part too large" );
+        }
+        const auto slack = static_cast < std::uint64_t >( slack_wide );
+        const std::uint64_t cap = static_cast < std::uint64_t >( max_part ) - static_cast < std::uint64_t >( min_part );
+        // ƽĲ֣fixed / k в֣ fixed % k λͬĲ
+        const std::uint64_t fixed = std::min( slack , static_cast < std::uint64_t >(
+                                                  std::floor( ( 1.0L - variance ) * static_cast < long double >( slack ) ) ) );
+        std::vector < std::uint64_t > even( k , fixed / k );
+        sampleDistinctIndices( k , {} , fixed % k , [&]( std::uint64_t i ) {
+            ++even[i];
+        } );
+        std::vector < std::uint64_t > room( k );
+        for ( std::size_t i = 0 ; i < k ; ++i ) room[i] = cap - even[i];
+        const std::vector < std::uint64_t > rest = cappedComposition( slack - fixed , room );
+        std::vector < long long > parts( k );
+        for ( std::size_t i = 0 ; i < k ; ++i ) {
+            parts[i] = static_cast < long long >( static_cast < std::uint64_t >( min_part ) + even[i] + rest[i] );
+        }
+        return parts;
+    }
+
+    WeightDistribution::WeightDistribution( Kind type , long long l , long long r , double opt )
+        : type( type ) , l( std::min( l , r ) ) , r( std::max( l , r ) ) , opt( opt ) {
+        if ( opt <= 0.0 ) throw std::invalid_argument( "opt must be positive" );
+        if ( type == Kind::SmallRange &&
+             static_cast < unsigned long long >( this->r ) - static_cast < unsigned long long >( this->l ) >= 65536 ) {
+            throw std::invalid_argument( "small_range requires r - l < 65536" );
+        }
+    }
+
+    void WeightDistribution::fill( const int *u , const int *v , long long *w , std::size_t count , int n ,
+                                   const int *position , int base ) const {
+        switch ( type ) {
+            case Kind::Uniform:
+                randomFill( w , w + count , l , r , opt );
+                return;
+            case Kind::SmallRange: {
+                // 16 λ Lemirexk ĸ 16 λΪ 16 λ [0, 2^16 mod k) ʱܾ
+                const std::uint32_t k = static_cast < std::uint32_t >( r - l ) + 1;
+                const std::uint32_t threshold = ( 65536u - k ) % k;
+                std::uint64_t bits = 0;
+                int left = 0;
+                for ( std::size_t i = 0 ; i < count ; ) {
+                    if ( left == 0 ) {
+                        bits = rng_64();
+                        left = 4;
+                    }
+                    const std::uint32_t x = static_cast < std::uint32_t >( bits & 0xFFFF ) * k;
+                    bits >>= 16;
+                    --left;
+                    if ( ( x & 0xFFFF ) < threshold ) continue;
+                    w[i++] = l + static_cast < long long >( x >> 16 );
+                }
+                return;
+            }
+            case Kind::Adversarial: {
+                // λò d  [1, n - 1] ӳ䵽 [l + (d-1)step, l + dstep)step = (r - l) / (n - 1)
+                const long double span = static_cast < long double >( r ) - static_cast < long double >( l );
+                const long double step = n > 1 ? span / ( n - 1 ) : 0.0L;
+                double buf[detail::BATCH_CHUNK];
+                for ( std::size_t done = 0 ; done < count ; ) {
+                    const std::size_t k = std::min( count - done , detail::BATCH_CHUNK );
+                    detail::uniform_unit_batch( buf , k );
+                    for ( std::size_t i = 0 ; i < k ; ++i , ++done ) {
+                        const long long d = position == nullptr
+                                                ? std::llabs( static_cast < long long >( u[done] ) - v[done] )
+                                                : std::llabs( static_cast < long long >( position[u[done] - base] ) -
+                                                              position[v[done] - base] );
+                        if ( d == 0 ) {
+                            w[done] = l;
+                            continue;
+                        }
+                        const long double offset = std::min( span , ( d - 1 + buf[i] ) * step );
+                        w[done] = l + static_cast < long long >( offset );
+                    }
+                }
+                return;
+            }
+        }
+    }
+
+    namespace {
+        /**
+         * @brief Ϊɺõı߼Ȩ
+         * @param labels ɺķصıУlabels[p] Ϊλ p Ľڵţ baseΪձʾżλ
+         * @note adversarial ɽṹеλòȨŴҺȻЧʱҪ n  int
+         */
+        void fillWeights( WeightedEdges &edges , const WeightDistribution &weights , int n , int base ,
+                          const std::vector < int > &labels ) {
+            edges.w.resize( edges.size() );
+            std::vector < int > position;
+            if ( weights.kind() == WeightDistribution::Kind::Adversarial && !labels.empty() ) {
+                position.resize( n );
+                for ( int p = 0 ; p < n ; ++p ) position[labels[p]] = p;
+            }
+            weights.fill( edges.u.data() , edges.v.data() , edges.w.data() , edges.size() , n ,
+                          position.empty() ? nullptr : position.data() , base );
+        }
+    }
+
+    namespace {
+        /**
+         * @brief У
+         */
+        void checkTreeArgs( int n , int root , double rho , bool vertices_rand ) {
+            if ( n <= 0 ) {
+                throw std::invalid_argument( "n must be positive" );
+            }
+            if ( root < 0 || root >= n ) {
+                throw std::invalid_argument( "root must be in range [0, n-1]" );
+            }
+            if ( rho <= 0.0 ) {
+                throw std::invalid_argument( "rho must be positive" );
+            }
+            if ( !vertices_rand && root != 0 ) {
+                throw std::invalid_argument(
+                    "When vertices_rand=false, root must be 0 "
+                    "to maintain parent < child ordering"
+                );
+            }
+        }
+
+        /**
+         * @brief ģΪԭʼ i = 1..n-1  f(i, p)p  [0, i-1] Ϊ i ĸڵ
+         */
+        template < typename Func > void forEachTreeParent( int n , double rho , Func &&f ) {
+            /*
+            
+                                 rho Ч                             
+            Щ
+               rho                        ̬                       
+            ੤
+               0.01       賓賓賓  (Σ 1)              
+               0.5        ǳ֧϶                              
+               1.0         O(log n)                   
+               2.0        Ĭֵ                              
+               5.0        ֧                                 
+               100+       賓賓賓賓賓賓  ( n-1)               
+            ة
+            */
+            std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
+            const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
+            for ( int i = 1 ; i < n ; ++i ) {
                 int p;
                 if ( is_uniform ) {
-                    std::uniform_int_distribution < int > pd( 0 , i - 1 );
-                    p = pd( rng_64 );
+                    // ѡ񸸽ڵ
+                    p = static_cast < int >( detail::bounded( rng_64 , i ) );
                 } else {
-                    double x = dist( rng_64 );
-                    double y = std::pow( x , 1.0 / rho );
-                    p = static_cast < int >( y * i );
-                    p = std::clamp( p , 0 , i - 1 );
+                    // ʹݱ任ȣrho Խx^(1/rho) Խӽ 1p Խӽ i-1
+                    double y = std::pow( dist( rng_64 ) , 1.0 / rho );
+                    p = std::clamp( static_cast < int >( y * i ) , 0 , i - 1 );
                 }
-
-                int parent_node = start + p;
-                parent[node] = parent_node;
-                edges.emplace_back( parent_node , node );
+                f( i , p );
             }
         }
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        // Step 4: ѡҽڵ
-        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
-        if ( vertices_rand ) {
-            std::vector < int > perm( n );
-            std::iota( perm.begin() , perm.end() , 0 );
-            // Fisher-Yates 
-            for ( int i = n - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < int > d( 0 , i );
-                std::swap( perm[i] , perm[d( rng_64 )] );
+
+        /**
+         * @brief ɽڵУperm[ԭʼ] = ±ţԭʼ 0 ֱӷΪ rootžȴ
+         */
+        std::vector < int > treeLabels( int n , int root ) {
+            // а root λ 0λǾ
+            std::vector < int > perm = randomPermutation( n , 0 );
+            std::swap( perm[0] , *std::find( perm.begin() , perm.end() , root ) );
+            return perm;
+        }
+
+        /**
+         * @brief ʽÿǸڵһ emit(, )Ѽ base
+         * @details vertices_rand ʱȰ±飬ٰӽڵ
+         *          ߵ˳򲻱¶˳򣨷򸸽ڵӽڵ֮ǰΪӽڵ֣
+         * @return vertices_rand ʱΪУԭʼ i ±Ϊ perm[i] baseΪ
+         */
+        template < typename Emit >
+        std::vector < int > generateTree( int n , int base , int root , double rho , bool vertices_rand ,
+                                          Emit &&emit ) {
+            checkTreeArgs( n , root , rho , vertices_rand );
+            if ( n == 1 ) return {};
+            if ( !vertices_rand ) {
+                // ʣб (u, v) u  v ĸף u < v
+                forEachTreeParent( n , rho , [&]( int i , int p ) {
+                    emit( p + base , i + base );
+                } );
+                return {};
             }
-            // Ӧ
-            std::vector < int > new_tree_id( n );
-            std::vector < int > new_parent( n );
-            std::vector < std::vector < int > > new_children( n );
-            std::vector < std::vector < int > > new_adj( n );
-            std::vector < std::pair < int , int > > new_edges;
-            new_edges.reserve( edges.size() );
+            std::vector < int > perm = treeLabels( n , root );
+            std::vector < int > parent( n );
+            forEachTreeParent( n , rho , [&]( int i , int p ) {
+                parent[perm[i]] = perm[p];
+            } );
+            for ( int v = 0 ; v < n ; ++v ) {
+                if ( v != root ) emit( parent[v] + base , v + base );
+            }
+            return perm;
+        }
+    }
 
-            auto map_id = [&]( int old_id ) ->int {
-                return old_id == -1 ? -1 : perm[old_id];
+    namespace {
+        /**
+         * @brief  0 Ϊдɱ߼Ű vertices_rand ңԭʼ 0 ӳΪ root
+         * @param edges Ϊ n - 1 Ļ
+         * @param parents parents(f) ÿԭʼ i  [1, n) һ f(i, p)p Ϊ i ĸڵ
+         *                vertices_rand = false ʱҪ p < i
+         *
+         * @details  i - 1 ߵӽڵ㼴ԭʼ i ±ţȰѱУԭʼ 1..n-1дӽڵһಢң
+         *          ڵ p ±ž edges[p - 1].secondp = 0 ʱΪ root赥顣
+         *          ԭذӽڵţѭûO(n)ߵ˳򲻱¶˳
+         */
+        template < typename Parents >
+        void fillLabeledTree( std::pair < int , int > *edges , int n , int base , int root , bool vertices_rand ,
+                              Parents &&parents ) {
+            if ( n <= 1 ) return;
+            if ( !vertices_rand ) {
+                parents( [&]( int i , int p ) {
+                    edges[i - 1] = { p + base , i + base };
+                } );
+                return;
+            }
+            for ( int i = 1 ; i < n ; ++i ) {
+                edges[i - 1].second = ( i == root ? 0 : i ) + base;
+            }
+            for ( int i = n - 2 ; i > 0 ; --i ) {
+                std::swap( edges[i].second ,
+                           edges[detail::bounded( rng_64 , static_cast < std::uint64_t >( i ) + 1 )].second );
+            }
+            parents( [&]( int i , int p ) {
+                edges[i - 1].first = p == 0 ? root + base : edges[p - 1].second;
+            } );
+            // ӽڵ± c rootӦλ± c - (c > root)
+            auto target = [&]( const std::pair < int , int > &e ) {
+                const int c = e.second - base;
+                return c - ( c > root ? 1 : 0 );
             };
+            for ( int i = 0 ; i < n - 1 ; ++i ) {
+                for ( int t = target( edges[i] ) ; t != i ; t = target( edges[i] ) ) {
+                    std::swap( edges[i] , edges[t] );
+                }
+            }
+        }
 
-            for ( int i = 0 ; i < n ; ++i ) {
-                int new_id = perm[i];
-                new_tree_id[new_id] = tree_id[i];
-                new_parent[new_id] = map_id( parent[i] );
+        /**
+         * @brief ̬У parents ɱ߼
+         */
+        template < typename Parents >
+        std::vector < std::pair < int , int > > labeledTree( int n , int base , int root , bool vertices_rand ,
+                                                             Parents &&parents ) {
+            checkTreeArgs( n , root , 1.0 , vertices_rand );
+            std::vector < std::pair < int , int > > edges( n - 1 );
+            fillLabeledTree( edges.data() , n , base , root , vertices_rand , std::forward < Parents >( parents ) );
+            return edges;
+        }
+    }
+
+    void RANDOMTREE::fill_random_tree( std::pair < int , int > *edges , int n , int base , int root , double rho ,
+                                       bool vertices_rand ) {
+        checkTreeArgs( n , root , rho , vertices_rand );
+        fillLabeledTree( edges , n , base , root , vertices_rand , [&]( auto &&f ) {
+            forEachTreeParent( n , rho , f );
+        } );
+    }
+
+    void RANDOMTREE::fill_random_tree_parent( int *parent , int n , int base , int root , double rho ,
+                                              bool vertices_rand ) {
+        checkTreeArgs( n , root , rho , vertices_rand );
+        parent[root] = -1;
+        if ( n == 1 ) return;
+        if ( !vertices_rand ) {
+            forEachTreeParent( n , rho , [&]( int i , int p ) {
+                parent[i] = p + base;
+            } );
+            return;
+        }
+        // ֱӰ±д룺parent[perm[i]] = perm[p]
+        const std::vector < int > perm = treeLabels( n , root );
+        forEachTreeParent( n , rho , [&]( int i , int p ) {
+            parent[perm[i]] = perm[p] + base;
+        } );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_tree( int n , int base , int root , double rho ,
+                                                                     bool vertices_rand ) {
+        checkTreeArgs( n , root , rho , vertices_rand );
+        std::vector < std::pair < int , int > > edges( n - 1 );
+        fill_random_tree( edges.data() , n , base , root , rho , vertices_rand );
+        return edges;
+    }
+
+    void RANDOMTREE::stream_tree( int n , const EdgeChunkSink &sink , int base , int root , double rho ,
+                                  bool vertices_rand , std::size_t chunk_size ) {
+        Chunker < std::pair < int , int > > out( sink , chunk_size );
+        generateTree( n , base , root , rho , vertices_rand , [&]( int u , int v ) {
+            out.push( u , v );
+        } );
+        out.flush();
+    }
+
+    std::vector < int >
+    RANDOMTREE::random_tree_parent( int n , int base , int root , double rho , bool vertices_rand ) {
+        checkTreeArgs( n , root , rho , vertices_rand );
+        std::vector < int > parent( n );
+        fill_random_tree_parent( parent.data() , n , base , root , rho , vertices_rand );
+        return parent;
+    }
+
+    WeightedEdges RANDOMTREE::random_weighted_tree( int n , const WeightDistribution &weights , int base , int root ,
+                                                    double rho , bool vertices_rand ) {
+        WeightedEdges edges;
+        edges.reserve( n > 0 ? n - 1 : 0 );
+        const std::vector < int > labels = generateTree( n , base , root , rho , vertices_rand , [&]( int u , int v ) {
+            edges.push_back( u , v );
+        } );
+        fillWeights( edges , weights , n , base , labels );
+        return edges;
+    }
+
+    namespace {
+        /**
+         * @brief Prfer Խ
+         * @param n ڵ (>= 2)
+         * @param code code(i) е i Ԫأi  [0, n-2)
+         * @param degree Ϊ n Ĺ
+         * @param emit emit(step, ڵ, ӽڵ) n - 1 Ϊstep  [0, n-1)
+         *
+         * @details ÿһɾȥСҶӣĸڵǵǰԪأɾȥҶӲٱȡ
+         *           emit ֱӸд degree[ӽڵ]鼴 degree ԭɣ
+         */
+        template < typename Code , typename Emit >
+        void decodePrufer( int n , Code &&code , int *degree , Emit &&emit ) {
+            std::fill( degree , degree + n , 1 );
+            for ( int i = 0 ; i < n - 2 ; ++i ) ++degree[code( i )];
+            int ptr = 0;
+            while ( degree[ptr] != 1 ) ++ptr;
+            int leaf = ptr;
+            for ( int i = 0 ; i < n - 2 ; ++i ) {
+                const int v = code( i );
+                emit( i , v , leaf );
+                if ( --degree[v] == 1 && v < ptr ) {
+                    // v ΪҶұСָ룬һֱɾ
+                    leaf = v;
+                } else {
+                    ++ptr;
+                    while ( degree[ptr] != 1 ) ++ptr;
+                    leaf = ptr;
+                }
             }
-            for ( const auto &[u, v] : edges ) {
-                new_edges.emplace_back( perm[u] , perm[v] );
+            emit( n - 2 , n - 1 , leaf );
+        }
+
+        /**
+         * @brief Prfer ıӳ䣺ʱĸ n - 1 ӳΪ root
+         * @return Ϊձʾֻ root  n - 1Ϊ label[] = ±
+         */
+        std::vector < int > pruferLabels( int n , int root , double opt , bool vertices_rand ) {
+            // opt = 1 ʱķֲ޹أż
+            if ( !vertices_rand || std::fabs( opt - 1.0 ) <= 1e-8 ) return {};
+            std::vector < int > label = randomPermutation( n , 0 );
+            std::swap( label[n - 1] , *std::find( label.begin() , label.end() , root ) );
+            return label;
+        }
+
+        void checkPruferArgs( int n , int root , double opt ) {
+            if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+            if ( root < 0 || root >= n ) throw std::invalid_argument( "root must be in range [0, n-1]" );
+            if ( opt <= 0.0 ) throw std::invalid_argument( "opt must be positive" );
+        }
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_prufer_tree( int n , int base , int root , double opt ,
+                                                                            bool vertices_rand ) {
+        checkPruferArgs( n , root , opt );
+        if ( n == 1 ) return {};
+        std::vector < std::pair < int , int > > edges( n - 1 );
+        // ݴڸߵ first У i ֻȡ i Ԫزд i 
+        for ( int i = 0 ; i < n - 2 ; ++i ) {
+            edges[i].first = static_cast < int >( random( 0 , n - 1 , opt ) );
+        }
+        {
+            std::vector < int > degree( n );
+            decodePrufer( n , [&]( int i ) { return edges[i].first; } , degree.data() ,
+                          [&]( int i , int p , int c ) { edges[i] = { p , c }; } );
+        }
+        const std::vector < int > label = pruferLabels( n , root , opt , vertices_rand );
+        auto map_id = [&]( int x ) {
+            if ( !label.empty() ) return label[x] + base;
+            return ( x == root ? n - 1 : x == n - 1 ? root : x ) + base;
+        };
+        for ( auto &[p , c] : edges ) {
+            p = map_id( p );
+            c = map_id( c );
+        }
+        // ˳Ҷӱأй¶ṹ
+        RandomBasic.shuffle( edges );
+        return edges;
+    }
+
+    std::vector < int > RANDOMTREE::random_prufer_tree_parent( int n , int base , int root , double opt ,
+                                                               bool vertices_rand ) {
+        checkPruferArgs( n , root , opt );
+        std::vector < int > parent( n , -1 );
+        if ( n == 1 ) return parent;
+        {
+            std::vector < int > code( n - 2 );
+            randomFill( code , 0 , n - 1 , opt );
+            // ֱ degree ԭ
+            decodePrufer( n , [&]( int i ) { return code[i]; } , parent.data() ,
+                          [&]( int , int p , int c ) { parent[c] = p; } );
+        }
+        parent[n - 1] = -1;
+        const std::vector < int > label = pruferLabels( n , root , opt , vertices_rand );
+        if ( label.empty() ) {
+            //  root  n - 1λã滻ֵ
+            std::swap( parent[root] , parent[n - 1] );
+            for ( int &p : parent ) {
+                if ( p == -1 ) continue;
+                p = ( p == root ? n - 1 : p == n - 1 ? root : p ) + base;
             }
-            for ( int t = 0 ; t < num_trees ; ++t ) {
-                roots[t] = perm[tree_start[t]];
+            return parent;
+        }
+        std::vector < int > relabeled( n );
+        for ( int v = 0 ; v < n ; ++v ) {
+            relabeled[label[v]] = parent[v] == -1 ? -1 : label[parent[v]] + base;
+        }
+        return relabeled;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::prufer_decode( const std::vector < int > &prufer , int base ) {
+        const int n = static_cast < int >( prufer.size() ) + 2;
+        for ( int x : prufer ) {
+            if ( x < 0 || x >= n ) throw std::invalid_argument( "prufer element out of range [0, n-1]" );
+        }
+        std::vector < std::pair < int , int > > edges( n - 1 );
+        std::vector < int > degree( n );
+        decodePrufer( n , [&]( int i ) { return prufer[i]; } , degree.data() ,
+                      [&]( int i , int p , int c ) { edges[i] = { p + base , c + base }; } );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_tree_chain(
+        int n , int base , int root , bool vertices_rand ) {
+        return random_tree( n , base , root , 1e9 , vertices_rand );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_tree_star(
+        int n , int base , int root , bool vertices_rand ) {
+        return random_tree( n , base , root , 1e-9 , vertices_rand );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_caterpillar( int n , int spine_length , int base ,
+                                                                            int root , bool vertices_rand ) {
+        if ( spine_length < 1 || spine_length > n ) {
+            throw std::invalid_argument( "spine_length must be in range [1, n]" );
+        }
+        // ԭʼ [0, spine_length) Ϊڵȹڵ
+        return labeledTree( n , base , root , vertices_rand , [&]( auto &&f ) {
+            for ( int i = 1 ; i < spine_length ; ++i ) f( i , i - 1 );
+            for ( int i = spine_length ; i < n ; ++i ) f( i , static_cast < int >( detail::bounded( rng_64 , spine_length ) ) );
+        } );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_broom( int n , int handle_length , int base , int root ,
+                                                                      bool vertices_rand ) {
+        if ( handle_length < 1 || handle_length > n ) {
+            throw std::invalid_argument( "handle_length must be in range [1, n]" );
+        }
+        // ԭʼ [0, handle_length) Ϊڵȫڱĩ
+        return labeledTree( n , base , root , vertices_rand , [&]( auto &&f ) {
+            for ( int i = 1 ; i < handle_length ; ++i ) f( i , i - 1 );
+            for ( int i = handle_length ; i < n ; ++i ) f( i , handle_length - 1 );
+        } );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_chain_star( int n , int chain_length , int base ,
+                                                                           int root , bool vertices_rand ) {
+        if ( chain_length < 0 || chain_length > n - 1 ) {
+            throw std::invalid_argument( "chain_length must be in range [0, n-1]" );
+        }
+        // ԭʼ [1, chain_length] ΪӸĳڵ㶼ǸҶ
+        return labeledTree( n , base , root , vertices_rand , [&]( auto &&f ) {
+            for ( int i = 1 ; i <= chain_length ; ++i ) f( i , i - 1 );
+            for ( int i = chain_length + 1 ; i < n ; ++i ) f( i , 0 );
+        } );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_kary_tree( int n , int k , int base , int root ,
+                                                                          bool vertices_rand ) {
+        if ( k < 1 ) throw std::invalid_argument( "k must be positive" );
+        // BFS ŵȫ k ڵ i ĸڵΪ (i - 1) / k
+        return labeledTree( n , base , root , vertices_rand , [&]( auto &&f ) {
+            for ( int i = 1 ; i < n ; ++i ) f( i , ( i - 1 ) / k );
+        } );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_degree_bounded_tree( int n , int max_degree , int base ,
+                                                                                    int root , bool vertices_rand ) {
+        if ( max_degree < 1 || ( max_degree == 1 && n > 2 ) ) {
+            throw std::invalid_argument( "max_degree must be >= 2 (or 1 when n <= 2)" );
+        }
+        // ݹڵڶδĽڵоѡ
+        // open ΪδĽڵ㣬˾ĩβ󵯳ÿڵ O(1)
+        return labeledTree( n , base , root , vertices_rand , [&]( auto &&f ) {
+            std::vector < int > open;
+            std::vector < int > degree( n , 0 );
+            open.reserve( n );
+            open.push_back( 0 );
+            for ( int i = 1 ; i < n ; ++i ) {
+                const std::size_t idx = detail::bounded( rng_64 , open.size() );
+                const int p = open[idx];
+                f( i , p );
+                if ( ++degree[p] == max_degree ) {
+                    open[idx] = open.back();
+                    open.pop_back();
+                }
+                // ½ڵռһȣ򸸽ڵ㣩
+                degree[i] = 1;
+                if ( degree[i] < max_degree ) open.push_back( i );
             }
-            tree_id = std::move( new_tree_id );
-            parent = std::move( new_parent );
-            edges = std::move( new_edges );
+        } );
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_binary_tree(
+        int n , int base , int root , double rho , bool vertices_rand , double balance ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( root < 0 || root >= n ) throw std::invalid_argument( "root out of range" );
+        if ( rho <= 0.0 ) throw std::invalid_argument( "rho must be positive" );
+        if ( balance < 0.0 || balance > 1.0 ) throw std::invalid_argument( "balance must be in [0, 1]" );
+        if ( !vertices_rand && root != 0 ) {
+            throw std::invalid_argument( "root must be 0 when vertices_rand=false" );
         }
-        for ( auto &[u,v] : edges ) {
-            u += base;
-            v += base;
+
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        // λÿڵṩղλλֻ¼ڵţջΣȷͰ
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        std::vector < int > parent( n , -1 );
+        std::vector < std::pair < int , int > > edges;
+        std::vector < int > base_parent( n , -1 );
+        std::vector < int > node_depth( n , 0 );
+        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
+        const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
+
+        // Ӳλ O(1) ȡ± idx Ĳλĩβ󵯳
+        auto take = []( std::vector < int > &slots , std::size_t idx ) ->int {
+            const int selected = slots[idx];
+            slots[idx] = slots.back();
+            slots.pop_back();
+            return selected;
+        };
+        // ½ڵ i ҵλ selected 
+        auto attach = [&]( int i , int selected ) {
+            base_parent[i] = selected;
+            node_depth[i] = node_depth[selected] + 1;
+        };
+
+        if ( is_uniform && balance <= 0.0 ) {
+            // 
+            // ΣпղλȸʣҪϢ
+            // 
+            std::vector < int > slots;
+            slots.reserve( n + 1 );
+            slots.push_back( 0 );
+            slots.push_back( 0 );
+            for ( int i = 1 ; i < n ; ++i ) {
+                attach( i , take( slots , detail::bounded( rng_64 , slots.size() ) ) );
+                slots.push_back( i );
+                slots.push_back( i );
+            }
+        } else {
+            // 
+            // һΣbuckets[d] Ϊ d Ŀղλڵ d - 1
+            // ״ fenwick άȲλڰѡȡλ
+            // λȴǳкrho ѡе
+            // rank = floor(x^(1/rho) * )rho ԽԽѡĲλ
+            // 
+            std::vector < std::vector < int > > buckets( n + 2 );
+            std::vector < int > fenwick( n + 2 , 0 );
+            const int max_depth = n + 1;
+            int log_depth = 1;
+            while ( ( log_depth << 1 ) <= max_depth ) log_depth <<= 1;
+            auto fenwick_add = [&]( int d , int delta ) {
+                for ( ; d <= max_depth ; d += d & -d ) fenwick[d] += delta;
+            };
+            // ص k  0 ʼλڵ
+            auto fenwick_find = [&]( int k ) ->int {
+                int pos = 0;
+                for ( int step = log_depth ; step > 0 ; step >>= 1 ) {
+                    if ( pos + step <= max_depth && fenwick[pos + step] <= k ) {
+                        pos += step;
+                        k -= fenwick[pos];
+                    }
+                }
+                return pos + 1;
+            };
+            auto add_slots = [&]( int node ) {
+                const int d = node_depth[node] + 1;
+                buckets[d].push_back( node );
+                buckets[d].push_back( node );
+                fenwick_add( d , 2 );
+            };
+            add_slots( 0 );
+            int total = 2;
+            // ǳķǿֻ²λܱȱռõĲλ
+            int min_depth = 1;
+            for ( int i = 1 ; i < n ; ++i ) {
+                while ( buckets[min_depth].empty() ) ++min_depth;
+                int d;
+                if ( balance > 0.0 && dist( rng_64 ) < balance ) {
+                    d = min_depth;
+                } else {
+                    int rank;
+                    if ( is_uniform ) {
+                        rank = static_cast < int >( detail::bounded( rng_64 , total ) );
+                    } else {
+                        double y = std::pow( dist( rng_64 ) , 1.0 / rho );
+                        rank = std::clamp( static_cast < int >( y * total ) , 0 , total - 1 );
+                    }
+                    d = fenwick_find( rank );
+                }
+                // ͬһڵĲλȸ
+                attach( i , take( buckets[d] , detail::bounded( rng_64 , buckets[d].size() ) ) );
+                fenwick_add( d , -1 );
+                add_slots( i );
+                ++total;
+            }
+        }
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        // ڵŴ
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        if ( !vertices_rand ) {
+            parent = std::move( base_parent );
+        } else {
+            std::vector < int > perm = randomPermutation( n , 0 );
+            // ȷԭʼ 0 ӳ䵽Ŀ root
+            int root_pos = std::find( perm.begin() , perm.end() , root ) - perm.begin();
+            std::swap( perm[0] , perm[root_pos] );
+
+            // perm[old_id] = new_id
+            // Ҫӳ䣺inv_perm[new_id] = old_id
+            std::vector < int > inv_perm( n );
+            for ( int i = 0 ; i < n ; ++i ) inv_perm[perm[i]] = i;
+
+            auto map_id = [&]( int old_id ) ->int {
+                return old_id == -1 ? -1 : perm[old_id];
+            };
+
+            for ( int old_id = 0 ; old_id < n ; ++old_id ) {
+                int new_id = perm[old_id];
+                parent[new_id] = map_id( base_parent[old_id] );
+            }
+        }
+        // б
+        for ( int v = 0 ; v < n ; ++v ) {
+            if ( parent[v] != -1 ) {
+                int p = parent[v];
+                edges.emplace_back( p + base , v + base );
+            }
+        }
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMTREE::random_forest_tree(
+        int n , int num_trees , int base , double rho , bool vertices_rand , double size_variance ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( num_trees <= 0 ) throw std::invalid_argument( "num_trees must be positive" );
+        if ( num_trees > n ) throw std::invalid_argument( "num_trees cannot exceed n" );
+        if ( rho <= 0.0 ) throw std::invalid_argument( "rho must be positive" );
+        if ( size_variance < 0.0 || size_variance > 1.0 ) {
+            throw std::invalid_argument( "size_variance must be in [0, 1]" );
+        }
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        // Step 1: ÿĴС
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        const std::vector < long long > composition = randomComposition( n , static_cast < std::size_t >( num_trees ) ,
+                                                                         1 , n , size_variance );
+        const std::vector < int > tree_sizes( composition.begin() , composition.end() );
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        // Step 2: ΪÿڵŷΧ
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        std::vector < int > tree_start( num_trees );
+        tree_start[0] = 0;
+        for ( int i = 1 ; i < num_trees ; ++i ) {
+            tree_start[i] = tree_start[i - 1] + tree_sizes[i - 1];
+        }
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        // Step 3: ÿ
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
+        const bool is_uniform = std::abs( rho - 1.0 ) < 1e-9;
+        std::vector < int > roots( num_trees );
+        std::vector < int > tree_id( n );
+        std::vector < int > parent( n , -1 );
+        std::vector < std::pair < int , int > > edges;
+        for ( int t = 0 ; t < num_trees ; ++t ) {
+            int start = tree_start[t];
+            int sz = tree_sizes[t];
+            roots[t] = start;
+            tree_id[start] = t;
+            parent[start] = -1;
+            for ( int i = 1 ; i < sz ; ++i ) {
+                int node = start + i;
+                tree_id[node] = t;
+                int p;
+                if ( is_uniform ) {
+                    p = static_cast < int >( detail::bounded( rng_64 , i ) );
+                } else {
+                    double x = dist( rng_64 );
+                    double y = std::pow( x , 1.0 / rho );
+                    p = static_cast < int >( y * i );
+                    p = std::clamp( p , 0 , i - 1 );
+                }
+
+                int parent_node = start + p;
+                parent[node] = parent_node;
+                edges.emplace_back( parent_node , node );
+            }
+        }
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        // Step 4: ѡҽڵ
+        // TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT
+        if ( vertices_rand ) {
+            const std::vector < int > perm = randomPermutation( n , 0 );
+            // Ӧ
+            std::vector < int > new_tree_id( n );
+            std::vector < int > new_parent( n );
+            std::vector < std::vector < int > > new_children( n );
+            std::vector < std::vector < int > > new_adj( n );
+            std::vector < std::pair < int , int > > new_edges;
+            new_edges.reserve( edges.size() );
+
+            auto map_id = [&]( int old_id ) ->int {
+                return old_id == -1 ? -1 : perm[old_id];
+            };
+
+            for ( int i = 0 ; i < n ; ++i ) {
+                int new_id = perm[i];
+                new_tree_id[new_id] = tree_id[i];
+                new_parent[new_id] = map_id( parent[i] );
+            }
+            for ( const auto &[u, v] : edges ) {
+                new_edges.emplace_back( perm[u] , perm[v] );
+            }
+            for ( int t = 0 ; t < num_trees ; ++t ) {
+                roots[t] = perm[tree_start[t]];
+            }
+            tree_id = std::move( new_tree_id );
+            parent = std::move( new_parent );
+            edges = std::move( new_edges );
+        }
+        for ( auto &[u,v] : edges ) {
+            u += base;
+            v += base;
+        }
+        return edges;
+    }
+
+    namespace {
+        /**
+         * @brief ڵУvertices_rand ʱΪУΪ
+         */
+        std::vector < int > graphLabels( int n , bool vertices_rand ) {
+            if ( vertices_rand ) return randomPermutation( n , 0 );
+            std::vector < int > perm( n );
+            std::iota( perm.begin() , perm.end() , 0 );
+            return perm;
+        }
+
+        /**
+         * @brief λÿռеıӳΪڵţ baseұߵ˳
+         */
+        void finishEdges( std::vector < std::pair < int , int > > &edges , const std::vector < int > &perm , int base ,
+                          bool directional ) {
+            for ( auto &[u , v] : edges ) {
+                u = perm[u] + base;
+                v = perm[v] + base;
+                if ( !directional && ( rng_64() >> 63 ) ) std::swap( u , v );
+            }
+            RandomBasic.shuffle( edges );
+        }
+
+        /**
+         * @brief Ǽ֮ıڹǼʱΪ 0еʱȡ
+         */
+        std::uint64_t extraEdges( long long m , std::uint64_t skeleton , std::uint64_t total ) {
+            const std::uint64_t wanted = static_cast < std::uint64_t >( std::max < long long >( m , 0 ) );
+            return wanted > skeleton ? std::min( wanted - skeleton , total - skeleton ) : 0;
+        }
+    }
+
+    std::pair < int , int > RANDOMGRAPH::valid_nm( int n , int m , bool connected , bool repeated_edges ,
+                                                   bool self_rings , bool directional , double opt ) {
+        // 
+        // У
+        // 
+        if ( n <= 0 ) {
+            throw std::invalid_argument(
+                "Node count n must be positive, got: " + std::to_string( n )
+            );
+        }
+        if ( m < 0 ) {
+            throw std::invalid_argument(
+                "Edge count m must be non-negative, got: " + std::to_string( m )
+            );
+        }
+        if ( opt <= 0 ) {
+            throw std::invalid_argument(
+                "opt must be positive, got: " + std::to_string( opt )
+            );
+        }
+        // 
+        // ĺϷΧ
+        // 
+        int min_edges = compute_min_edges( n , connected , directional );
+        long long max_edges = compute_max_edges( n , repeated_edges , self_rings , directional );
+
+        // ʵܳû m
+        long long effective_max = std::min( max_edges , static_cast < long long >( m ) );
+        // 
+        // Լ
+        // 
+        // 飺 m ǷСҪ
+        if ( m < min_edges ) {
+            std::ostringstream oss;
+            oss << "Edge count m=" << m << " is less than minimum required ("
+                    << min_edges << ") for "
+                    << ( connected ? "connected " : "" )
+                    << ( directional ? "directed" : "undirected" ) << " graph with n="
+                    << n << " nodes";
+            throw std::invalid_argument( oss.str() );
+        }
+        // 飺СǷ񳬹ϲӦ÷
+        if ( min_edges > effective_max ) {
+            std::ostringstream oss;
+            oss << "Cannot satisfy constraints: min_edges=" << min_edges
+                    << " > effective_max=" << effective_max;
+            throw std::invalid_argument( oss.str() );
+        }
+        // 
+        // ʹ opt ֵ
+        // 
+        // Ŀֵ [min_edges, effective_max] Χڣӽ m
+        int target_m = static_cast < int >( std::min( static_cast < long long >( m ) , effective_max ) );
+        //  m
+        int adjusted_m;
+        if ( min_edges == effective_max ) {
+            // ֻһϷֵ
+            adjusted_m = min_edges;
+        } else {
+            std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
+            // opt ԽԽС
+            // noise_scale  (0, 1)opt   ʱ 0
+            double noise_scale = 1.0 / ( 1.0 + opt );
+            //  [min_edges, effective_max] Χ
+            long long range = effective_max - min_edges;
+            double noise = noise_scale * range * ( 2.0 * dist( rng_64 ) - 1.0 );
+            adjusted_m = static_cast < int >( std::clamp(
+                static_cast < long long >( target_m + static_cast < long long >( noise ) ) ,
+                static_cast < long long >( min_edges ) ,
+                effective_max
+            ) );
+        }
+        // 
+        // 
+        // 
+        // n = n;
+        // m = adjusted_m;
+        // is_valid = true;
+        // std::ostringstream oss;
+        // oss << "Valid params: n=" << n << ", m=" << m
+        //         << " (range: [" << min_edges << ", " << max_edges << "])";
+        // std::string message = oss.str();
+
+        return { n , adjusted_m };
+    }
+
+    namespace {
+        /**
+         * @brief ͼģÿߵһ emit(u, v)Ѽ base
+         * @details ڡλáռй죬ʱӳΪڵţ
+         *          Step 1 ͨǼܣΪܶٻ·Ϊ
+         *          Step 2 ںѡߵ±ռвʣı
+         *          ˳ΪǼǰں󣨳ȡʱ±򣩣÷
+         * @return λõڵŵУ baseûбʱΪ
+         */
+        template < typename Emit >
+        std::vector < int > generateGraph( int n , long long m , bool connected , bool repeated_edges ,
+                                           bool self_rings , bool directional , int base , Emit &&emit ) {
+            if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+            if ( m < 0 ) throw std::invalid_argument( "m must be non-negative" );
+            if ( m == 0 ) return {};
+
+            // кѡ߰±ţֻ±ռнУöٺѡ
+            const PairSpace space{ n , directional , self_rings };
+            const std::uint64_t total = space.size();
+            if ( total == 0 ) return {};
+
+            std::vector < int > perm = randomPermutation( n , 0 );
+            auto add_edge = [&]( int u , int v ) {
+                u = perm[u];
+                v = perm[v];
+                if ( !directional && ( rng_64() >> 63 ) ) std::swap( u , v );
+                emit( u + base , v + base );
+            };
+
+            // 
+            // Step 1: ͨԹ
+            // 
+            std::vector < std::uint64_t > skeleton;
+            std::uint64_t used = 0;
+            if ( connected && n > 1 ) {
+                auto add_skeleton = [&]( int u , int v ) {
+                    // n = 2 ·߷෴ظ
+                    if ( !repeated_edges ) skeleton.push_back( space.encode( u , v ) );
+                    add_edge( u , v );
+                    ++used;
+                };
+                if ( directional ) {
+                    // Ҫ n : 0->1->2->...->n-1->0
+                    for ( int i = 0 ; i < n ; ++i ) add_skeleton( i , ( i + 1 ) % n );
+                } else {
+                    // Ҫ n-1 
+                    for ( int i = 1 ; i < n ; ++i ) {
+                        add_skeleton( static_cast < int >( detail::bounded( rng_64 , i ) ) , i );
+                    }
+                }
+            }
+
+            // 
+            // Step 2: ±ռвʣı
+            // 
+            std::uint64_t remaining = static_cast < std::uint64_t >( m ) > used ? static_cast < std::uint64_t >( m ) - used : 0;
+            auto add_index = [&]( std::uint64_t idx ) {
+                const auto [u , v] = space.decode( idx );
+                add_edge( u , v );
+            };
+            if ( repeated_edges ) {
+                // رߣȲ
+                for ( ; remaining > 0 ; --remaining ) add_index( detail::bounded( rng_64 , total ) );
+            } else {
+                // ʱȡ
+                sampleDistinctIndices( total , skeleton , std::min( remaining , total - used ) , add_index );
+            }
+            return perm;
+        }
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_graph( int n , long long m , bool connected ,
+                                                                       bool repeated_edges , bool self_rings ,
+                                                                       bool directional , int base ) {
+        std::vector < std::pair < int , int > > edges;
+        if ( m > 0 && n > 0 ) {
+            const std::uint64_t cap = PairSpace{ n , directional , self_rings }.size();
+            edges.reserve( static_cast < std::size_t >(
+                repeated_edges ? m : std::max < std::uint64_t >( std::min < std::uint64_t >( m , cap ) , n ) ) );
+        }
+        generateGraph( n , m , connected , repeated_edges , self_rings , directional , base , [&]( int u , int v ) {
+            edges.emplace_back( u , v );
+        } );
+        // ս
+        RandomBasic.shuffle( edges );
+        return edges;
+    }
+
+    namespace {
+        /**
+         * @brief ҴȨ߼бߵ˳u / v ͬʱδȨ
+         */
+        void shuffleEdges( WeightedEdges &edges ) {
+            for ( std::size_t i = edges.size() ; i > 1 ; --i ) {
+                const std::size_t j = detail::bounded( rng_64 , i );
+                std::swap( edges.u[i - 1] , edges.u[j] );
+                std::swap( edges.v[i - 1] , edges.v[j] );
+            }
+        }
+    }
+
+    WeightedEdges RANDOMGRAPH::random_weighted_graph( int n , long long m , const WeightDistribution &weights ,
+                                                      bool connected , bool repeated_edges , bool self_rings ,
+                                                      bool directional , int base ) {
+        WeightedEdges edges;
+        if ( m > 0 && n > 0 ) {
+            const std::uint64_t cap = PairSpace{ n , directional , self_rings }.size();
+            edges.reserve( static_cast < std::size_t >(
+                repeated_edges ? m : std::max < std::uint64_t >( std::min < std::uint64_t >( m , cap ) , n ) ) );
+        }
+        const std::vector < int > labels = generateGraph( n , m , connected , repeated_edges , self_rings , directional ,
+                                                          base , [&]( int u , int v ) {
+            edges.push_back( u , v );
+        } );
+        shuffleEdges( edges );
+        fillWeights( edges , weights , n , base , labels );
+        return edges;
+    }
+
+    void RANDOMGRAPH::stream_graph( int n , long long m , const EdgeChunkSink &sink , bool connected ,
+                                    bool repeated_edges , bool self_rings , bool directional , int base ,
+                                    std::size_t chunk_size ) {
+        Chunker < std::pair < int , int > > out( sink , chunk_size , true );
+        generateGraph( n , m , connected , repeated_edges , self_rings , directional , base , [&]( int u , int v ) {
+            out.push( u , v );
+        } );
+        out.flush();
+    }
+
+    namespace {
+        /**
+         * @brief ͼģÿߵһ emit(u, v)Ѽ base
+         * @details ˳ΪǼǰں󣬵÷
+         */
+        template < typename Emit >
+        void generateBinaryGraph( int n1 , int n2 , long long m , bool directional , int base , bool connected ,
+                                  Emit &&emit ) {
+            if ( n1 <= 0 || n2 <= 0 ) {
+                throw std::invalid_argument( "n1 and n2 must be positive" );
+            }
+            if ( m < 0 ) throw std::invalid_argument( "m must be non-negative" );
+            // ± idx < cross Ϊ u  n1 + vu = idx / n2v = idx % n2ʱ [cross, 2cross) ΪӦķ
+            const std::uint64_t N2 = static_cast < std::uint64_t >( n2 );
+            const std::uint64_t cross = static_cast < std::uint64_t >( n1 ) * N2;
+            const std::uint64_t total = directional ? 2 * cross : cross;
+            auto add_edge = [&]( std::uint64_t idx ) {
+                const bool reversed = idx >= cross;
+                const std::uint64_t r = reversed ? idx - cross : idx;
+                const int u = static_cast < int >( r / N2 ) + base , v = n1 + static_cast < int >( r % N2 ) + base;
+                if ( reversed ) emit( v , u );
+                else emit( u , v );
+            };
+
+            std::vector < std::uint64_t > skeleton;
+            if ( connected && n1 + n2 > 1 ) {
+                // ȷһڵ㣬ڵ㰴˳ҵһѷõڵ
+                std::vector < int > order = graphLabels( n1 + n2 , true );
+                const bool first_left = order[0] < n1;
+                for ( int i = 1 ; ; ++i ) {
+                    if ( ( order[i] < n1 ) != first_left ) {
+                        std::swap( order[1] , order[i] );
+                        break;
+                    }
+                }
+                std::vector < int > placed[2];
+                placed[first_left ? 0 : 1].push_back( order[0] );
+                skeleton.reserve( n1 + n2 - 1 );
+                for ( int i = 1 ; i < n1 + n2 ; ++i ) {
+                    const int x = order[i] , side = x < n1 ? 0 : 1;
+                    const std::vector < int > &other = placed[side ^ 1];
+                    const int y = other[detail::bounded( rng_64 , other.size() )];
+                    const int u = side == 0 ? x : y , v = ( side == 0 ? y : x ) - n1;
+                    const bool reversed = directional && ( rng_64() >> 63 );
+                    skeleton.push_back( ( reversed ? cross : 0 ) + static_cast < std::uint64_t >( u ) * N2 + v );
+                    placed[side].push_back( x );
+                }
+            }
+            const std::uint64_t extra = extraEdges( m , skeleton.size() , total );
+            for ( std::uint64_t idx : skeleton ) add_edge( idx );
+            sampleDistinctIndices( total , skeleton , extra , add_edge );
+        }
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_binary_graph(
+        int n1 , int n2 , long long m , bool directional , int base , bool connected ) {
+        std::vector < std::pair < int , int > > edges;
+        if ( n1 > 0 && n2 > 0 && m > 0 ) {
+            const std::uint64_t cap = static_cast < std::uint64_t >( n1 ) * static_cast < std::uint64_t >( n2 ) *
+                                      ( directional ? 2 : 1 );
+            const std::uint64_t tree = connected ? static_cast < std::uint64_t >( n1 ) + n2 - 1 : 0;
+            edges.reserve( static_cast < std::size_t >(
+                std::max( std::min < std::uint64_t >( static_cast < std::uint64_t >( m ) , cap ) , tree ) ) );
+        }
+        generateBinaryGraph( n1 , n2 , m , directional , base , connected , [&]( int u , int v ) {
+            edges.emplace_back( u , v );
+        } );
+        RandomBasic.shuffle( edges );
+        return edges;
+    }
+
+    void RANDOMGRAPH::stream_binary_graph( int n1 , int n2 , long long m , const EdgeChunkSink &sink ,
+                                           bool directional , int base , bool connected , std::size_t chunk_size ) {
+        Chunker < std::pair < int , int > > out( sink , chunk_size , true );
+        generateBinaryGraph( n1 , n2 , m , directional , base , connected , [&]( int u , int v ) {
+            out.push( u , v );
+        } );
+        out.flush();
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_bounded_binary_graph(
+        int n1 , int n2 , long long m , int max_left_degree , int max_right_degree , int base ) {
+        if ( n1 <= 0 || n2 <= 0 ) {
+            throw std::invalid_argument( "n1 and n2 must be positive" );
+        }
+        if ( m < 0 ) throw std::invalid_argument( "m must be non-negative" );
+        if ( max_left_degree < 1 || max_right_degree < 1 ) {
+            throw std::invalid_argument( "max degrees must be positive" );
+        }
+        const int cap_left = std::min( max_left_degree , n2 ) , cap_right = std::min( max_right_degree , n1 );
+        const std::uint64_t N2 = static_cast < std::uint64_t >( n2 );
+        const std::uint64_t count = std::min( { static_cast < std::uint64_t >( m ) ,
+                                                static_cast < std::uint64_t >( n1 ) * cap_left ,
+                                                static_cast < std::uint64_t >( n2 ) * cap_right } );
+        // δĽڵб֮ĩβɾ
+        std::vector < int > open_left = graphLabels( n1 , false ) , open_right = graphLabels( n2 , false );
+        std::vector < int > left_room( n1 , cap_left ) , right_room( n2 , cap_right );
+        IndexSet seen( static_cast < std::uint64_t >( n1 ) * N2 , count );
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( count ) );
+        auto add_edge = [&]( int u , int v ) {
+            edges.emplace_back( u , n1 + v );
+            --left_room[u];
+            --right_room[v];
+        };
+        for ( int failures = 0 ; edges.size() < count && failures < 32 ; ) {
+            const std::size_t i = detail::bounded( rng_64 , open_left.size() );
+            const std::size_t j = detail::bounded( rng_64 , open_right.size() );
+            const int u = open_left[i] , v = open_right[j];
+            if ( !seen.insert( static_cast < std::uint64_t >( u ) * N2 + v ) ) {
+                ++failures;
+                continue;
+            }
+            failures = 0;
+            add_edge( u , v );
+            if ( left_room[u] == 0 ) {
+                open_left[i] = open_left.back();
+                open_left.pop_back();
+            }
+            if ( right_room[v] == 0 ) {
+                open_right[j] = open_right.back();
+                open_right.pop_back();
+            }
+        }
+        // ײеı˵δڵ֮ĵԴãʣΪ O(m)ֱö
+        if ( edges.size() < count ) {
+            RandomBasic.shuffle( open_left );
+            RandomBasic.shuffle( open_right );
+            for ( int u : open_left ) {
+                for ( int v : open_right ) {
+                    if ( edges.size() == count || left_room[u] == 0 ) break;
+                    if ( right_room[v] > 0 && seen.insert( static_cast < std::uint64_t >( u ) * N2 + v ) ) {
+                        add_edge( u , v );
+                    }
+                }
+            }
+        }
+        finishEdges( edges , graphLabels( n1 + n2 , false ) , base , true );
+        return edges;
+    }
+
+    namespace {
+        /**
+         * @brief  DAG ģÿߵһ emit(u, v)u λ v ֮ǰѼ base
+         * @return 򣨵 i λõĽڵţ baseûбʱΪ
+         */
+        template < typename Emit > std::vector < int > generateDag( int n , long long m , int base , Emit &&emit ) {
+            if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+            if ( m < 0 ) throw std::invalid_argument( "m must be non-negative" );
+            // λö (i, j), i < j ±ռ
+            const PairSpace space{ n , false , false };
+            const std::uint64_t total = space.size();
+            const std::uint64_t count = std::min( static_cast < std::uint64_t >( m ) , total );
+            if ( count == 0 ) return {};
+            // 
+            std::vector < int > topo_order = randomPermutation( n , 0 );
+            // ɱߣ±Ϊλ i < j֤ u  v ֮ǰ
+            sampleDistinctIndices( total , {} , count , [&]( std::uint64_t idx ) {
+                const auto [i , j] = space.decode( idx );
+                emit( topo_order[i] + base , topo_order[j] + base );
+            } );
+            return topo_order;
+        }
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_dag_graph( int n , long long m , int base ) {
+        std::vector < std::pair < int , int > > edges;
+        if ( n > 0 && m > 0 ) {
+            edges.reserve( static_cast < std::size_t >(
+                std::min < std::uint64_t >( m , PairSpace{ n , false , false }.size() ) ) );
+        }
+        generateDag( n , m , base , [&]( int u , int v ) {
+            edges.emplace_back( u , v );
+        } );
+        // ұߵ˳
+        RandomBasic.shuffle( edges );
+        return edges;
+    }
+
+    void RANDOMGRAPH::stream_dag_graph( int n , long long m , const EdgeChunkSink &sink , int base ,
+                                        std::size_t chunk_size ) {
+        Chunker < std::pair < int , int > > out( sink , chunk_size , true );
+        generateDag( n , m , base , [&]( int u , int v ) {
+            out.push( u , v );
+        } );
+        out.flush();
+    }
+
+    WeightedEdges RANDOMGRAPH::random_weighted_dag_graph( int n , long long m , const WeightDistribution &weights ,
+                                                          int base ) {
+        WeightedEdges edges;
+        if ( n > 0 && m > 0 ) {
+            edges.reserve( static_cast < std::size_t >(
+                std::min < std::uint64_t >( m , PairSpace{ n , false , false }.size() ) ) );
+        }
+        const std::vector < int > labels = generateDag( n , m , base , [&]( int u , int v ) {
+            edges.push_back( u , v );
+        } );
+        shuffleEdges( edges );
+        fillWeights( edges , weights , n , base , labels );
+        return edges;
+    }
+
+    WeightedEdges RANDOMGRAPH::anti_spfa_graph( int n , long long m , bool directional , int base , int rows ,
+                                                long long max_weight ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( max_weight < 1 ) throw std::invalid_argument( "max_weight must be positive" );
+        if ( rows < 0 || rows > n ) throw std::invalid_argument( "rows must be in range [0, n]" );
+        // ĬԼ n / 4 УԼΪ 16 
+        if ( rows == 0 ) rows = std::max( 1 , static_cast < int >( std::sqrt( static_cast < double >( n ) ) / 4 ) );
+        const int R = rows;
+        const long long small_weight = std::min < long long >( 10 , max_weight );
+        // λ p Ӧ p / R е p % R Уڵż p + base1 ŵΪǣ
+        auto column_end = [&]( int p ) {
+            // һĩβ
+            return static_cast < int >( std::min < long long >( n , ( static_cast < long long >( p ) / R + 2 ) * R ) );
+        };
+        auto is_grid = [&]( int u , int v ) {
+            return ( v == u + 1 && v % R != 0 ) || v == u + R;
+        };
+
+        WeightedEdges edges;
+        // ʱ񻡱ǣu  vu < vݾ
+        auto add_edge = [&]( int u , int v , bool shortcut ) {
+            if ( directional && shortcut && ( rng_64() >> 63 ) ) std::swap( u , v );
+            edges.push_back( u + base , v + base );
+        };
+        // ֲѡߣÿλֱһĩβλ۳
+        std::uint64_t grid = 0 , local = 0;
+        for ( int p = 0 ; p < n ; ++p ) {
+            if ( ( p + 1 ) % R != 0 && p + 1 < n ) ++grid;
+            if ( p + R < n ) ++grid;
+            local += static_cast < std::uint64_t >( column_end( p ) - p - 1 );
+        }
+        local -= grid;
+        const std::uint64_t wanted = static_cast < std::uint64_t >( std::max < long long >( m , 0 ) );
+        // ݾȡֲѡߵһ룬֤ܾЧ
+        const std::uint64_t shortcuts = std::min( wanted > grid ? wanted - grid : 0 , local / 2 );
+        edges.reserve( static_cast < std::size_t >( grid + shortcuts ) );
+
+        for ( int p = 0 ; p < n ; ++p ) {
+            if ( ( p + 1 ) % R != 0 && p + 1 < n ) add_edge( p , p + 1 , false );
+            if ( p + R < n ) add_edge( p , p + R , false );
+        }
+        // ݾֻͬУȨֵıѡ·
+        IndexSet seen( static_cast < std::uint64_t >( n ) * 2 * R , shortcuts );
+        for ( std::uint64_t k = 0 ; k < shortcuts ; ) {
+            const int u = static_cast < int >( detail::bounded( rng_64 , n ) );
+            const int width = column_end( u ) - u - 1;
+            if ( width <= 0 ) continue;
+            const int v = u + 1 + static_cast < int >( detail::bounded( rng_64 , width ) );
+            if ( is_grid( u , v ) ) continue;
+            if ( !seen.insert( static_cast < std::uint64_t >( u ) * 2 * R + ( v - u - 1 ) ) ) continue;
+            add_edge( u , v , true );
+            ++k;
+        }
+        shuffleEdges( edges );
+        // ȨڣߺСм䣨򣩱ݾ [1, max_weight] 
+        // ·ڸ֮䷴۷ SPFA չ˳ܴ
+        edges.w.resize( edges.size() );
+        for ( std::size_t i = 0 ; i < edges.size() ; ++i ) {
+            const int u = std::min( edges.u[i] , edges.v[i] ) - base , v = std::max( edges.u[i] , edges.v[i] ) - base;
+            const long long range = v == u + 1 && v % R != 0 ? small_weight : max_weight;
+            edges.w[i] = 1 + static_cast < long long >( detail::bounded( rng_64 , range ) );
+        }
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_grid_graph( int rows , int cols , bool vertices_rand ,
+                                                                            int base ) {
+        if ( rows <= 0 || cols <= 0 ) throw std::invalid_argument( "rows and cols must be positive" );
+        if ( static_cast < long long >( rows ) * cols > std::numeric_limits < int >::max() ) {
+            throw std::invalid_argument( "rows * cols is too large" );
+        }
+        const int n = rows * cols;
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( 2LL * n - rows - cols ) );
+        for ( int r = 0 ; r < rows ; ++r ) {
+            for ( int c = 0 ; c < cols ; ++c ) {
+                const int p = r * cols + c;
+                if ( c + 1 < cols ) edges.emplace_back( p , p + 1 );
+                if ( r + 1 < rows ) edges.emplace_back( p , p + cols );
+            }
+        }
+        finishEdges( edges , graphLabels( n , vertices_rand ) , base , false );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_cactus_graph( int n , double cycle_ratio ,
+                                                                              int max_cycle_length ,
+                                                                              bool vertices_rand , int base ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( cycle_ratio < 0.0 || cycle_ratio > 1.0 ) throw std::invalid_argument( "cycle_ratio must be in [0, 1]" );
+        if ( max_cycle_length == 0 ) {
+            max_cycle_length = std::max( 3 , static_cast < int >( std::sqrt( static_cast < double >( n ) ) ) );
+        }
+        if ( max_cycle_length < 3 ) throw std::invalid_argument( "max_cycle_length must be at least 3" );
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( n - 1 ) + static_cast < std::size_t >( ( n - 1 ) / 2 ) );
+        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
+        // λ [0, c) ѷã¿Ľڵ㶼λãֻвֹҽӵ aÿһ
+        for ( int c = 1 ; c < n ; ) {
+            const int a = static_cast < int >( detail::bounded( rng_64 , c ) );
+            const int room = n - c + 1; // ໹ܷŵĽڵ a
+            if ( room >= 3 && dist( rng_64 ) < cycle_ratio ) {
+                const int hi = std::min( max_cycle_length , room );
+                const int len = 3 + static_cast < int >( detail::bounded( rng_64 , hi - 2 ) );
+                // a  c  c+1  ...  c+len-2  a
+                edges.emplace_back( a , c );
+                for ( int i = 1 ; i < len - 1 ; ++i ) edges.emplace_back( c + i - 1 , c + i );
+                edges.emplace_back( c + len - 2 , a );
+                c += len - 1;
+            } else {
+                edges.emplace_back( a , c );
+                ++c;
+            }
+        }
+        finishEdges( edges , graphLabels( n , vertices_rand ) , base , false );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_wheel_graph( int n , bool vertices_rand , int base ) {
+        if ( n < 4 ) throw std::invalid_argument( "wheel graph requires n >= 4" );
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( 2 * ( n - 1 ) ) );
+        // λ 0 Ϊģ1..n-1 Ϊ
+        for ( int i = 1 ; i < n ; ++i ) {
+            edges.emplace_back( 0 , i );
+            edges.emplace_back( i , i + 1 < n ? i + 1 : 1 );
+        }
+        finishEdges( edges , graphLabels( n , vertices_rand ) , base , false );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_complete_graph( int n , bool directional , int base ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        const std::uint64_t total = PairSpace{ n , directional , false }.size();
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( total ) );
+        for ( int u = 0 ; u < n ; ++u ) {
+            for ( int v = directional ? 0 : u + 1 ; v < n ; ++v ) {
+                if ( u != v ) edges.emplace_back( u , v );
+            }
+        }
+        finishEdges( edges , graphLabels( n , true ) , base , directional );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_functional_graph( int n , bool self_rings , int base ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( !self_rings && n < 2 ) throw std::invalid_argument( "n must be at least 2 without self rings" );
+        // ޹أңְУsecond  f 
+        std::vector < std::pair < int , int > > edges( n );
+        for ( int i = 0 ; i < n ; ++i ) {
+            int f;
+            if ( self_rings ) {
+                f = static_cast < int >( detail::bounded( rng_64 , n ) );
+            } else {
+                //  [0, n-1) ѡȡ i
+                f = static_cast < int >( detail::bounded( rng_64 , n - 1 ) );
+                if ( f >= i ) ++f;
+            }
+            edges[i] = { i + base , f + base };
+        }
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_scc_graph( int n , long long m , int k ,
+                                                                           bool vertices_rand , int base ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( k < 1 || k > n ) throw std::invalid_argument( "k must be in range [1, n]" );
+        // λðУȺ󼴷
+        const std::vector < long long > composition = randomComposition( n , static_cast < std::size_t >( k ) );
+        const std::vector < int > sizes( composition.begin() , composition.end() );
+        std::vector < int > group_start( n );
+        for ( int g = 0 , s = 0 ; g < k ; s += sizes[g++] ) {
+            std::fill( group_start.begin() + s , group_start.begin() + s + sizes[g] , s );
+        }
+        // ѡ u  vv  [group_start[u], n)  v  uoffset[u] Ϊ u ĺѡ±ռе
+        std::vector < std::uint64_t > offset( n + 1 , 0 );
+        for ( int u = 0 ; u < n ; ++u ) offset[u + 1] = offset[u] + static_cast < std::uint64_t >( n - group_start[u] - 1 );
+        const std::uint64_t total = offset[n];
+        auto encode = [&]( int u , int v ) {
+            return offset[u] + static_cast < std::uint64_t >( v - group_start[u] - ( v > u ? 1 : 0 ) );
+        };
+
+        std::vector < std::pair < int , int > > edges;
+        std::vector < std::uint64_t > skeleton;
+        // 򻷱֤ǿͨ
+        for ( int g = 0 , s = 0 ; g < k ; s += sizes[g++] ) {
+            if ( sizes[g] < 2 ) continue;
+            for ( int i = 0 ; i < sizes[g] ; ++i ) {
+                const int u = s + i , v = s + ( i + 1 ) % sizes[g];
+                skeleton.push_back( encode( u , v ) );
+                edges.emplace_back( u , v );
+            }
+        }
+        const std::uint64_t extra = extraEdges( m , skeleton.size() , total );
+        edges.reserve( static_cast < std::size_t >( skeleton.size() + extra ) );
+        sampleDistinctIndices( total , skeleton , extra , [&]( std::uint64_t idx ) {
+            const int u = static_cast < int >( std::upper_bound( offset.begin() , offset.end() , idx ) - offset.begin() ) - 1;
+            int v = group_start[u] + static_cast < int >( idx - offset[u] );
+            if ( v >= u ) ++v;
+            edges.emplace_back( u , v );
+        } );
+        finishEdges( edges , graphLabels( n , vertices_rand ) , base , true );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_bcc_graph( int n , long long m , int k ,
+                                                                           bool vertices_rand , int base ) {
+        if ( n < 2 ) throw std::invalid_argument( "n must be at least 2" );
+        if ( k < 1 || k > n - 1 ) throw std::invalid_argument( "k must be in range [1, n-1]" );
+        //  b ɹҽӵ attach[b] λ [start[b], start[b] + sizes[b]) ɣھֲ 0 Ϊҽӵ
+        const std::vector < long long > composition = randomComposition( n - 1 , static_cast < std::size_t >( k ) );
+        const std::vector < int > sizes( composition.begin() , composition.end() );
+        std::vector < int > start( k ) , attach( k );
+        // offset[b] Ϊ b ڵ±ռе
+        std::vector < std::uint64_t > offset( k + 1 , 0 );
+        for ( int b = 0 , c = 1 ; b < k ; c += sizes[b++] ) {
+            start[b] = c;
+            attach[b] = static_cast < int >( detail::bounded( rng_64 , c ) );
+            const std::uint64_t s = static_cast < std::uint64_t >( sizes[b] ) + 1;
+            offset[b + 1] = offset[b] + s * ( s - 1 ) / 2;
+        }
+        const std::uint64_t total = offset[k];
+        auto global = [&]( int b , int local ) {
+            return local == 0 ? attach[b] : start[b] + local - 1;
+        };
+
+        std::vector < std::pair < int , int > > edges;
+        std::vector < std::uint64_t > skeleton;
+        for ( int b = 0 ; b < k ; ++b ) {
+            const int s = sizes[b] + 1;
+            const PairSpace block{ s , false , false };
+            // СΪ 2 ĿţΪܶٻ 0  1  ...  s-1  0
+            const int cycle_edges = s == 2 ? 1 : s;
+            for ( int i = 0 ; i < cycle_edges ; ++i ) {
+                const int a = i , c = ( i + 1 ) % s;
+                skeleton.push_back( offset[b] + block.encode( a , c ) );
+                edges.emplace_back( global( b , a ) , global( b , c ) );
+            }
+        }
+        const std::uint64_t extra = extraEdges( m , skeleton.size() , total );
+        edges.reserve( static_cast < std::size_t >( skeleton.size() + extra ) );
+        sampleDistinctIndices( total , skeleton , extra , [&]( std::uint64_t idx ) {
+            const int b = static_cast < int >( std::upper_bound( offset.begin() , offset.end() , idx ) - offset.begin() ) - 1;
+            const auto [a , c] = PairSpace{ sizes[b] + 1 , false , false }.decode( idx - offset[b] );
+            edges.emplace_back( global( b , a ) , global( b , c ) );
+        } );
+        finishEdges( edges , graphLabels( n , vertices_rand ) , base , false );
+        return edges;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_diameter_graph( int n , long long m , int diameter ,
+                                                                                int base ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( diameter < ( n > 1 ? 1 : 0 ) || diameter > n - 1 ) {
+            throw std::invalid_argument( "diameter must be in range [1, n-1]" );
+        }
+        if ( diameter <= 1 ) return random_complete_graph( n , false , base );
+        const int D = diameter;
+        // ˳ţ0..D Ϊ·ڵڿչڵ£̳вţ·ľ + 1
+        std::vector < int > layer( n ) , depth( n , 0 );
+        std::vector < std::pair < int , int > > tree;
+        tree.reserve( n - 1 );
+        std::vector < int > expandable;
+        for ( int i = 0 ; i <= D ; ++i ) {
+            layer[i] = i;
+            if ( i > 0 ) tree.emplace_back( i - 1 , i );
+            if ( i > 0 && i < D ) expandable.push_back( i );
+        }
+        for ( int id = D + 1 ; id < n ; ++id ) {
+            const int w = expandable[detail::bounded( rng_64 , expandable.size() )];
+            layer[id] = layer[w];
+            depth[id] = depth[w] + 1;
+            tree.emplace_back( w , id );
+            //  l ڵ·ľ벻 min(l, D - l) dist <= ֮ + Ų <= D
+            if ( depth[id] < std::min( layer[id] , D - layer[id] ) ) expandable.push_back( id );
+        }
+        // żõλãlayer_end[l] Ϊ l 㣨֮ǰĽڵ
+        std::vector < int > layer_end( D + 1 , 0 ) , pos( n );
+        for ( int id = 0 ; id < n ; ++id ) ++layer_end[layer[id]];
+        for ( int l = 1 ; l <= D ; ++l ) layer_end[l] += layer_end[l - 1];
+        {
+            std::vector < int > next( D + 1 , 0 );
+            for ( int l = 1 ; l <= D ; ++l ) next[l] = layer_end[l - 1];
+            for ( int id = 0 ; id < n ; ++id ) pos[id] = next[layer[id]]++;
+        }
+        // ѡ p < q Ҳ 1q  (p, layer_end[min(l + 1, D)])
+        std::vector < int > pos_layer( n );
+        for ( int id = 0 ; id < n ; ++id ) pos_layer[pos[id]] = layer[id];
+        std::vector < std::uint64_t > offset( n + 1 , 0 );
+        for ( int p = 0 ; p < n ; ++p ) {
+            offset[p + 1] = offset[p] + static_cast < std::uint64_t >(
+                layer_end[std::min( pos_layer[p] + 1 , D )] - p - 1 );
+        }
+        const std::uint64_t total = offset[n];
+
+        std::vector < std::pair < int , int > > edges;
+        std::vector < std::uint64_t > skeleton;
+        skeleton.reserve( tree.size() );
+        for ( auto [u , v] : tree ) {
+            const int p = std::min( pos[u] , pos[v] ) , q = std::max( pos[u] , pos[v] );
+            skeleton.push_back( offset[p] + static_cast < std::uint64_t >( q - p - 1 ) );
+        }
+        const std::uint64_t extra = extraEdges( m , skeleton.size() , total );
+        edges.reserve( static_cast < std::size_t >( skeleton.size() + extra ) );
+        for ( auto [u , v] : tree ) edges.emplace_back( pos[u] , pos[v] );
+        sampleDistinctIndices( total , skeleton , extra , [&]( std::uint64_t idx ) {
+            const int p = static_cast < int >( std::upper_bound( offset.begin() , offset.end() , idx ) - offset.begin() ) - 1;
+            edges.emplace_back( p , p + 1 + static_cast < int >( idx - offset[p] ) );
+        } );
+        finishEdges( edges , graphLabels( n , true ) , base , false );
+        return edges;
+    }
+
+    namespace {
+        /**
+         * @brief ѸͨڵһλÿռУ׷ӵ edges ĩβ
+         */
+        void connectComponents( int n , std::vector < std::pair < int , int > > &edges ) {
+            std::vector < int > parent( n );
+            std::iota( parent.begin() , parent.end() , 0 );
+            auto find = [&]( int x ) {
+                while ( parent[x] != x ) x = parent[x] = parent[parent[x]];
+                return x;
+            };
+            for ( const auto &[u , v] : edges ) {
+                const int a = find( u ) , b = find( v );
+                if ( a != b ) parent[a] = b;
+            }
+            // ˳ɨڵ㣬ÿͨһĽڵΪ
+            std::vector < int > reps;
+            std::vector < char > seen( n , 0 );
+            for ( int x : graphLabels( n , true ) ) {
+                const int r = find( x );
+                if ( !seen[r] ) {
+                    seen[r] = 1;
+                    reps.push_back( x );
+                }
+            }
+            for ( std::size_t i = 1 ; i < reps.size() ; ++i ) {
+                edges.emplace_back( reps[i] , reps[detail::bounded( rng_64 , i )] );
+            }
         }
-        return edges;
     }
 
-    std::pair < int , int > RANDOMGRAPH::valid_nm( int n , int m , bool connected , bool repeated_edges ,
-                                                   bool self_rings , bool directional , double opt ) {
-        // 
-        // У
-        // 
-        if ( n <= 0 ) {
-            throw std::invalid_argument(
-                "Node count n must be positive, got: " + std::to_string( n )
-            );
+    std::vector < int > RANDOMGRAPH::power_law_degrees( int n , double gamma , int min_degree , int max_degree ) {
+        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
+        if ( gamma <= 1.0 ) throw std::invalid_argument( "gamma must be greater than 1" );
+        if ( max_degree == 0 ) max_degree = n - 1;
+        if ( min_degree < 1 || min_degree > max_degree ) {
+            throw std::invalid_argument( "degrees must satisfy 1 <= min_degree <= max_degree" );
         }
-        if ( m < 0 ) {
-            throw std::invalid_argument(
-                "Edge count m must be non-negative, got: " + std::to_string( m )
-            );
+        if ( min_degree == max_degree && ( static_cast < long long >( n ) * min_degree ) % 2 != 0 ) {
+            throw std::invalid_argument( "n * degree must be even" );
         }
-        if ( opt <= 0 ) {
-            throw std::invalid_argument(
-                "opt must be positive, got: " + std::to_string( opt )
-            );
+        //  Pareto ֲȡd = min  U^(-1/(gamma-1))U  (0, 1]
+        const double inv = -1.0 / ( gamma - 1.0 );
+        std::vector < int > degrees( n );
+        std::vector < double > buf( std::min < std::size_t >( n , detail::BATCH_CHUNK ) );
+        long long sum = 0;
+        for ( int done = 0 ; done < n ; ) {
+            const int k = std::min( n - done , static_cast < int >( buf.size() ) );
+            detail::uniform_unit_batch( buf.data() , k );
+            for ( int i = 0 ; i < k ; ++i , ++done ) {
+                const double d = min_degree * std::pow( 1.0 - buf[i] , inv );
+                degrees[done] = d >= max_degree ? max_degree : static_cast < int >( d );
+                sum += degrees[done];
+            }
         }
-        // 
-        // ĺϷΧ
-        // 
-        int min_edges = compute_min_edges( n , connected , directional );
-        long long max_edges = compute_max_edges( n , repeated_edges , self_rings , directional );
-
-        // ʵܳû m
-        long long effective_max = std::min( max_edges , static_cast < long long >( m ) );
-        // 
-        // Լ
-        // 
-        // 飺 m ǷСҪ
-        if ( m < min_edges ) {
-            std::ostringstream oss;
-            oss << "Edge count m=" << m << " is less than minimum required ("
-                    << min_edges << ") for "
-                    << ( connected ? "connected " : "" )
-                    << ( directional ? "directed" : "undirected" ) << " graph with n="
-                    << n << " nodes";
-            throw std::invalid_argument( oss.str() );
+        // ܺΪʱһڵĶ
+        while ( sum % 2 != 0 ) {
+            int &d = degrees[detail::bounded( rng_64 , n )];
+            if ( d < max_degree ) {
+                ++d;
+                ++sum;
+            } else if ( d > min_degree ) {
+                --d;
+                --sum;
+            }
         }
-        // 飺СǷ񳬹ϲӦ÷
-        if ( min_edges > effective_max ) {
-            std::ostringstream oss;
-            oss << "Cannot satisfy constraints: min_edges=" << min_edges
-                    << " > effective_max=" << effective_max;
-            throw std::invalid_argument( oss.str() );
+        return degrees;
+    }
+
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_configuration_graph( const std::vector < int > &degrees ,
+                                                                                     bool simple , int base ) {
+        const int n = static_cast < int >( degrees.size() );
+        std::uint64_t stubs_count = 0;
+        for ( int d : degrees ) {
+            if ( d < 0 ) throw std::invalid_argument( "degrees must be non-negative" );
+            stubs_count += static_cast < std::uint64_t >( d );
         }
-        // 
-        // ʹ opt ֵ
-        // 
-        // Ŀֵ [min_edges, effective_max] Χڣӽ m
-        int target_m = static_cast < int >( std::min( static_cast < long long >( m ) , effective_max ) );
-        //  m
-        int adjusted_m;
-        if ( min_edges == effective_max ) {
-            // ֻһϷֵ
-            adjusted_m = min_edges;
-        } else {
-            std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
-            // opt ԽԽС
-            // noise_scale  (0, 1)opt   ʱ 0
-            double noise_scale = 1.0 / ( 1.0 + opt );
-            //  [min_edges, effective_max] Χ
-            long long range = effective_max - min_edges;
-            double noise = noise_scale * range * ( 2.0 * dist( rng_64 ) - 1.0 );
-            adjusted_m = static_cast < int >( std::clamp(
-                static_cast < long long >( target_m + static_cast < long long >( noise ) ) ,
-                static_cast < long long >( min_edges ) ,
-                effective_max
-            ) );
+        if ( stubs_count % 2 != 0 ) throw std::invalid_argument( "sum of degrees must be even" );
+        // ÿ߼¼ڵ㣬Һһ
+        std::vector < int > stubs;
+        stubs.reserve( static_cast < std::size_t >( stubs_count ) );
+        for ( int i = 0 ; i < n ; ++i ) stubs.insert( stubs.end() , degrees[i] , i );
+        RandomBasic.shuffle( stubs );
+        const std::uint64_t half = stubs_count / 2;
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( half ) );
+        const PairSpace space{ n , false , false };
+        IndexSet seen( simple ? space.size() : 0 , simple ? half : 0 );
+        for ( std::uint64_t i = 0 ; i < half ; ++i ) {
+            const int u = stubs[2 * i] , v = stubs[2 * i + 1];
+            if ( simple && ( u == v || !seen.insert( space.encode( u , v ) ) ) ) continue;
+            edges.emplace_back( u , v );
         }
-        // 
-        // 
-        // 
-        // n = n;
-        // m = adjusted_m;
-        // is_valid = true;
-        // std::ostringstream oss;
-        // oss << "Valid params: n=" << n << ", m=" << m
-        //         << " (range: [" << min_edges << ", " << max_edges << "])";
-        // std::string message = oss.str();
+        finishEdges( edges , graphLabels( n , false ) , base , false );
+        return edges;
+    }
 
-        return { n , adjusted_m };
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_chung_lu_graph( const std::vector < double > &weights ,
+                                                                                bool connected , int base ) {
+        const int n = static_cast < int >( weights.size() );
+        if ( n == 0 ) return {};
+        // λðȨֵorder[λ] = ڵ
+        std::vector < int > order( n );
+        std::iota( order.begin() , order.end() , 0 );
+        std::sort( order.begin() , order.end() , [&]( int a , int b ) {
+            return weights[a] > weights[b];
+        } );
+        std::vector < double > w( n );
+        double sum = 0;
+        for ( int i = 0 ; i < n ; ++i ) {
+            w[i] = weights[order[i]];
+            if ( !( w[i] >= 0.0 ) ) throw std::invalid_argument( "weights must be non-negative" );
+            sum += w[i];
+        }
+        std::vector < std::pair < int , int > > edges;
+        edges.reserve( static_cast < std::size_t >( sum / 2 ) + n );
+        std::uniform_real_distribution < double > dist( 0.0 , 1.0 );
+        // Miller-Hagberg̶ u  v ʱʵԵǰ p ηֲ q / p 
+        for ( int u = 0 ; u + 1 < n && sum > 0 ; ++u ) {
+            int v = u + 1;
+            double p = std::min( w[u] * w[v] / sum , 1.0 );
+            while ( v < n && p > 0 ) {
+                if ( p < 1.0 ) {
+                    const double skip = std::floor( std::log( 1.0 - dist( rng_64 ) ) / std::log1p( -p ) );
+                    if ( skip >= n - v ) break;
+                    v += static_cast < int >( skip );
+                }
+                const double q = std::min( w[u] * w[v] / sum , 1.0 );
+                if ( dist( rng_64 ) * p < q ) edges.emplace_back( u , v );
+                p = q;
+                ++v;
+            }
+        }
+        if ( connected ) connectComponents( n , edges );
+        finishEdges( edges , order , base , false );
+        return edges;
     }
 
-    std::vector < std::pair < int , int > > RANDOMGRAPH::random_graph( int n , int m , bool connected ,
-                                                                       bool repeated_edges , bool self_rings ,
-                                                                       bool directional , int base ) {
-        // 
-        // У
-        // 
+    std::vector < std::pair < int , int > > RANDOMGRAPH::random_power_law_graph( int n , long long m , double gamma ,
+                                                                                 bool connected , int base ) {
         if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
         if ( m < 0 ) throw std::invalid_argument( "m must be non-negative" );
+        if ( gamma <= 1.0 ) throw std::invalid_argument( "gamma must be greater than 1" );
+        //  i  c(i + 1)^(-1/(gamma-1))ܺΪ 2mضϵ n - 1
+        const double alpha = 1.0 / ( gamma - 1.0 );
+        std::vector < double > weights( n );
+        double raw = 0;
+        for ( int i = 0 ; i < n ; ++i ) raw += weights[i] = std::pow( i + 1.0 , -alpha );
+        const double scale = 2.0 * static_cast < double >( m ) / raw;
+        for ( double &x : weights ) x = std::min( x * scale , n - 1.0 );
+        // Ȩֵҽڵ
+        RandomBasic.shuffle( weights );
+        return random_chung_lu_graph( weights , connected , base );
+    }
+
+    namespace {
+        /**
+         * @brief β count Ԫʱ std::unordered_set Ͱ
+         * @details ͰֻȡԪظʵֵԣlibstdc++ Ϊ +  1
+         *          ֱõǰ׼ģ⣬Ӳ
+         */
+        std::size_t finalBucketCount( std::size_t count ) {
+            std::unordered_set < long long > probe;
+            for ( std::size_t i = 0 ; i < count ; ++i ) probe.insert( static_cast < long long >( i ) );
+            return probe.bucket_count();
+        }
+    }
 
-        // ҪǿͨͼСУ
-        int min_required = 0;
-        if ( connected && n > 1 ) {
-            min_required = directional ? n : n - 1;
+    std::vector < long long > antiHashKeys( std::size_t count , long long max_value , std::size_t bucket_count ) {
+        if ( count == 0 ) return {};
+        if ( max_value <= 0 ) throw std::invalid_argument( "max_value must be positive" );
+        if ( bucket_count == 0 ) bucket_count = finalBucketCount( count );
+        // std::hash < long long > Ϊӳ䣬ͰΪ key % bucket_countȫȡ bucket_count ı
+        const std::uint64_t multiples = static_cast < std::uint64_t >( max_value ) / bucket_count;
+        if ( multiples < count ) {
+            throw std::invalid_argument( "max_value too small: need count * bucket_count <= max_value" );
         }
-        if ( m < min_required ) {
-            // ѡ׳쳣ú߼Ϊ
-            // throw std::invalid_argument("m is not enough for connected graph");
+        std::vector < long long > keys;
+        keys.reserve( count );
+        sampleDistinctIndices( multiples , {} , count , [&]( std::uint64_t k ) {
+            keys.push_back( static_cast < long long >( ( k + 1 ) * bucket_count ) );
+        } );
+        RandomBasic.shuffle( keys );
+        return keys;
+    }
+
+    namespace {
+        /**
+         * @brief  n ַ sinkgen(out, count) д count ַ
+         */
+        template < typename Gen >
+        void streamChars( std::size_t n , const CharChunkSink &sink , std::size_t chunk_size , Gen &&gen ) {
+            Chunker < char > out( sink , chunk_size );
+            out.append( n , gen );
+            out.flush();
         }
 
-        std::vector < Edge > edges;
-        edges.reserve( m );
-        if ( m == 0 || n == 0 ) return {};
+        template < typename Gen > std::string generateChars( std::size_t n , Gen &&gen ) {
+            std::string result( n , '\0' );
+            gen( result.data() , n );
+            return result;
+        }
 
-        // 
-        // ȥؼ
-        // 
-        struct PairHash {
-            size_t operator()( const std::pair < int , int > &p ) const {
-                return std::hash < long long >()( static_cast < long long >( p.first ) * 1000000007LL + p.second );
-            }
-        };
-        std::unordered_set < std::pair < int , int > , PairHash > edge_set;
+        /**
+         * @brief Fibonacci  i ַ 1 ʼΪ 2 + floor(i*phi) - floor((i+1)*phi)floor(i*phi)  64 λСۼ
+         * @details phi С  2^64  0x9E3779B97F4A7C15ض i2^-64 ԶС i*phi ľ루Լ 1 / (5 i)
+         */
+        class FibonacciWordGen {
+            public:
+                FibonacciWordGen( char a , char b ) : a( a ) , b( b ) {
+                }
 
-        auto try_add_edge = [&]( int u , int v ) ->bool {
-            if ( !self_rings && u == v ) return false;
-            std::pair < int , int > e = { u , v };
-            if ( !directional && u > v ) std::swap( e.first , e.second );
+                void operator()( char *out , std::size_t count ) {
+                    for ( std::size_t i = 0 ; i < count ; ++i ) {
+                        const std::uint64_t next_frac = frac + PHI_FRAC;
+                        const std::uint64_t next_floor = floor + 1 + ( next_frac < frac );
+                        out[i] = next_floor - floor == 1 ? b : a;
+                        floor = next_floor;
+                        frac = next_frac;
+                    }
+                }
 
-            if ( !repeated_edges ) {
-                if ( edge_set.count( e ) ) return false;
-                edge_set.insert( e );
-            }
-            edges.push_back( { u , v } );
-            return true;
+            private:
+                static constexpr std::uint64_t PHI_FRAC = 0x9E3779B97F4A7C15ULL;
+                char a , b;
+                // ǰ floor(i*phi)  i*phi С֣ʼ i = 1
+                std::uint64_t floor = 1 , frac = PHI_FRAC;
         };
 
-        // 
-        // Step 1: ͨԹ (޸ͼͨ)
-        // 
-        if ( connected && n > 1 ) {
-            std::vector < int > perm( n );
-            std::iota( perm.begin() , perm.end() , 0 );
-            // Shuffle nodes
-            for ( int i = n - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < int > dist( 0 , i );
-                std::swap( perm[i] , perm[dist( rng_64 )] );
-            }
-
-            if ( directional ) {
-                // ޸ͼһܶٻ· (Circle)֤ǿͨ
-                // Ҫ n : 0->1->2->...->n-1->0
-                for ( int i = 0 ; i < n ; ++i ) {
-                    int u = perm[i];
-                    int v = perm[( i + 1 ) % n];
-                    try_add_edge( u , v );
+        class ThueMorseGen {
+            public:
+                ThueMorseGen( char a , char b ) : a( a ) , b( b ) {
                 }
-            } else {
-                // ͼ (Tree)
-                // Ҫ n-1 
-                for ( int i = 1 ; i < n ; ++i ) {
-                    std::uniform_int_distribution < int > parent_dist( 0 , i - 1 );
-                    int parent_idx = parent_dist( rng_64 );
-                    try_add_edge( perm[parent_idx] , perm[i] );
+
+                void operator()( char *out , std::size_t count ) {
+                    for ( std::size_t i = 0 ; i < count ; ++i , ++index ) {
+                        out[i] = __builtin_parityll( index ) ? b : a;
+                    }
+                }
+
+            private:
+                char a , b;
+                std::uint64_t index = 0;
+        };
+
+        /**
+         * @brief ַлַͬ״γ˳
+         */
+        std::string distinctChars( const std::string &chars ) {
+            bool seen[256] = {};
+            std::string result;
+            for ( char c : chars ) {
+                const auto u = static_cast < unsigned char >( c );
+                if ( !seen[u] ) {
+                    seen[u] = true;
+                    result.push_back( c );
                 }
             }
+            return result;
         }
 
-        // 
-        // Step 2: ʣı
-        // 
-        int remaining = m - static_cast < int >( edges.size() );
-
-        if ( remaining > 0 ) {
-            // ܱ
-            long long max_possible = compute_max_edges( n , repeated_edges , self_rings , directional );
-            double density = static_cast < double >( m ) / std::max( 1LL , max_possible );
-
-            std::uniform_int_distribution < int > node_dist( 0 , n - 1 );
-
-            if ( density < 0.5 || repeated_edges ) {
-                // ϡͼ
-                int max_attempts = remaining * 100 + 10000;
-                int attempts = 0;
-                while ( remaining > 0 && attempts < max_attempts ) {
-                    int u = node_dist( rng_64 );
-                    int v = node_dist( rng_64 );
-                    if ( try_add_edge( u , v ) ) {
-                        --remaining;
+        /**
+         * @brief ڴ pattern ظ breaks λøĳַ
+         */
+        class PeriodicGen {
+            public:
+                PeriodicGen( std::size_t n , std::size_t period , std::size_t breaks , const std::string &chars ) {
+                    if ( period == 0 ) throw std::invalid_argument( "period must be positive" );
+                    if ( chars.empty() ) throw std::invalid_argument( "chars must not be empty" );
+                    if ( breaks > n ) throw std::invalid_argument( "breaks must not exceed n" );
+                    distinct = distinctChars( chars );
+                    if ( breaks > 0 && distinct.size() < 2 ) {
+                        throw std::invalid_argument( "chars must contain at least two distinct characters" );
                     }
-                    ++attempts;
+                    pattern = Alphabet( chars ).generate( std::min( period , std::max < std::size_t >( n , 1 ) ) ,
+                                                          true );
+                    positions.reserve( breaks );
+                    sampleDistinctIndices( n , {} , breaks , [&]( std::uint64_t idx ) {
+                        positions.push_back( idx );
+                    } );
+                    std::sort( positions.begin() , positions.end() );
                 }
-                // ʧܶףö
-                if ( remaining > 0 && !repeated_edges ) {
-                    for ( int u = 0 ; u < n && remaining > 0 ; ++u ) {
-                        int v_start = directional ? 0 : u;
-                        for ( int v = v_start ; v < n && remaining > 0 ; ++v ) {
-                            if ( try_add_edge( u , v ) ) --remaining;
-                        }
+
+                void operator()( char *out , std::size_t count ) {
+                    const std::size_t period = pattern.size();
+                    for ( std::size_t i = 0 ; i < count ; ) {
+                        // һθƵĩβ
+                        const std::size_t len = std::min( count - i , period - phase );
+                        std::memcpy( out + i , pattern.data() + phase , len );
+                        i += len;
+                        phase += len;
+                        if ( phase == period ) phase = 0;
                     }
-                }
-            } else {
-                // ͼкѡߺϴ
-                std::vector < std::pair < int , int > > all_edges;
-                // ԤСԼrealloc
-                all_edges.reserve( directional ? ( long long ) n * n : ( long long ) n * ( n + 1 ) / 2 );
-
-                // ޸ö߼
-                for ( int u = 0 ; u < n ; ++u ) {
-                    // ͼv0ʼͼvuʼ
-                    int v_start = directional ? 0 : u;
-                    for ( int v = v_start ; v < n ; ++v ) {
-                        // Ի
-                        if ( !self_rings && u == v ) continue;
-
-                        // ǷѴڣStep 1 ɵıߣ
-                        std::pair < int , int > e = { u , v };
-                        if ( !directional && u > v ) std::swap( e.first , e.second );
-
-                        if ( !edge_set.count( e ) ) {
-                            all_edges.push_back( { u , v } );
-                        }
+                    const std::uint64_t end = offset + count;
+                    for ( ; next < positions.size() && positions[next] < end ; ++next ) {
+                        char &c = out[positions[next] - offset];
+                        //  distinct ȥ c ַоѡȡ c ʱһַ
+                        const char r = distinct[detail::bounded( rng_64 , distinct.size() - 1 )];
+                        c = r == c ? distinct.back() : r;
                     }
+                    offset = end;
                 }
 
-                // Fisher-Yates ϴƲѡȡ
-                for ( size_t i = all_edges.size() ; i > 0 && remaining > 0 ; --i ) {
-                    std::uniform_int_distribution < size_t > dist( 0 , i - 1 );
-                    size_t j = dist( rng_64 );
-                    std::swap( all_edges[i - 1] , all_edges[j] );
+            private:
+                std::string pattern , distinct;
+                std::vector < std::uint64_t > positions;
+                std::size_t next = 0 , phase = 0;
+                std::uint64_t offset = 0;
+        };
+
+        /**
+         * @brief شγ 1 + Geom(1 / mean_run)ÿַһβͬ
+         */
+        class LowEntropyGen {
+            public:
+                LowEntropyGen( double mean_run , const std::string &chars ) : distinct( distinctChars( chars ) ) {
+                    if ( distinct.empty() ) throw std::invalid_argument( "chars must not be empty" );
+                    if ( !( mean_run >= 1.0 ) ) throw std::invalid_argument( "mean_run must be at least 1" );
+                    // γ - 1 ӳɹ 1 / mean_run ļηֲ
+                    log_q = mean_run > 1.0 ? std::log1p( -1.0 / mean_run ) : 0.0;
+                    current = distinct[detail::bounded( rng_64 , distinct.size() )];
+                    remaining = runLength();
+                }
 
-                    auto &e = all_edges[i - 1];
-                    if ( try_add_edge( e.first , e.second ) ) {
-                        --remaining;
+                void operator()( char *out , std::size_t count ) {
+                    for ( std::size_t i = 0 ; i < count ; ) {
+                        if ( remaining == 0 ) {
+                            if ( distinct.size() > 1 ) {
+                                const char r = distinct[detail::bounded( rng_64 , distinct.size() - 1 )];
+                                current = r == current ? distinct.back() : r;
+                            }
+                            remaining = runLength();
+                        }
+                        const std::size_t len = static_cast < std::size_t >(
+                            std::min < std::uint64_t >( remaining , count - i ) );
+                        std::memset( out + i , current , len );
+                        i += len;
+                        remaining -= len;
                     }
                 }
-            }
-        }
 
-        // 
-        // Step 3: ս
-        // 
-        for ( int i = static_cast < int >( edges.size() ) - 1 ; i > 0 ; --i ) {
-            std::uniform_int_distribution < int > dist( 0 , i );
-            std::swap( edges[i] , edges[dist( rng_64 )] );
-        }
+            private:
+                std::string distinct;
+                double log_q;
+                char current;
+                std::uint64_t remaining;
+                std::uniform_real_distribution < double > dist{ 0.0 , 1.0 };
+
+                std::uint64_t runLength() {
+                    if ( log_q == 0.0 ) return 1;
+                    const double extra = std::floor( std::log( 1.0 - dist( rng_64 ) ) / log_q );
+                    // ضϵ 2^62ⳬ uint64
+                    return 1 + static_cast < std::uint64_t >( std::min( extra , 4.6e18 ) );
+                }
+        };
+    }
+
+    std::string RANDOMSTRING::fibonacci_word( std::size_t n , char a , char b ) {
+        return generateChars( n , FibonacciWordGen( a , b ) );
+    }
+
+    void RANDOMSTRING::stream_fibonacci_word( std::size_t n , const CharChunkSink &sink , char a , char b ,
+                                              std::size_t chunk_size ) {
+        streamChars( n , sink , chunk_size , FibonacciWordGen( a , b ) );
+    }
+
+    std::string RANDOMSTRING::thue_morse( std::size_t n , char a , char b ) {
+        return generateChars( n , ThueMorseGen( a , b ) );
+    }
+
+    void RANDOMSTRING::stream_thue_morse( std::size_t n , const CharChunkSink &sink , char a , char b ,
+                                          std::size_t chunk_size ) {
+        streamChars( n , sink , chunk_size , ThueMorseGen( a , b ) );
+    }
+
+    std::string RANDOMSTRING::periodic_string( std::size_t n , std::size_t period , std::size_t breaks ,
+                                               const std::string &chars ) {
+        return generateChars( n , PeriodicGen( n , period , breaks , chars ) );
+    }
+
+    void RANDOMSTRING::stream_periodic_string( std::size_t n , std::size_t period , const CharChunkSink &sink ,
+                                               std::size_t breaks , const std::string &chars ,
+                                               std::size_t chunk_size ) {
+        streamChars( n , sink , chunk_size , PeriodicGen( n , period , breaks , chars ) );
+    }
+
+    std::string RANDOMSTRING::low_entropy_string( std::size_t n , double mean_run , const std::string &chars ) {
+        return generateChars( n , LowEntropyGen( mean_run , chars ) );
+    }
 
-        if ( !directional ) {
-            std::bernoulli_distribution coin( 0.5 );
-            for ( auto &e : edges ) {
-                if ( coin( rng_64 ) ) std::swap( e.u , e.v );
+    void RANDOMSTRING::stream_low_entropy_string( std::size_t n , double mean_run , const CharChunkSink &sink ,
+                                                  const std::string &chars , std::size_t chunk_size ) {
+        streamChars( n , sink , chunk_size , LowEntropyGen( mean_run , chars ) );
+    }
+
+    namespace {
+        std::uint64_t mulMod( std::uint64_t a , std::uint64_t b , std::uint64_t mod ) {
+#if defined( __SIZEOF_INT128__ )
+            return static_cast < std::uint64_t >( static_cast < unsigned __int128 >( a ) * b % mod );
+#else
+            std::uint64_t result = 0;
+            for ( a %= mod ; b > 0 ; b >>= 1 ) {
+                if ( b & 1 ) result = result >= mod - a ? result - ( mod - a ) : result + a;
+                a = a >= mod - a ? a - ( mod - a ) : a + a;
             }
+            return result;
+#endif
         }
 
-        std::vector < std::pair < int , int > > result;
-        result.reserve( edges.size() );
-        for ( const auto &[u, v] : edges ) {
-            result.emplace_back( u + base , v + base );
+        /**
+         * @brief base^emod Ϊ 0 ʱ 2^64 Ȼ
+         */
+        std::uint64_t powMod( std::uint64_t base , std::uint64_t e , std::uint64_t mod ) {
+            std::uint64_t result = mod == 1 ? 0 : 1;
+            for ( ; e > 0 ; e >>= 1 ) {
+                if ( e & 1 ) result = mod ? mulMod( result , base , mod ) : result * base;
+                base = mod ? mulMod( base , base , mod ) : base * base;
+            }
+            return result;
         }
-        return result;
-    }
 
-    std::vector < std::pair < int , int > > RANDOMGRAPH::random_binary_graph(
-        int n1 , int n2 , int m , bool directional ,
-        int base ) {
-        if ( n1 <= 0 || n2 <= 0 ) {
-            throw std::invalid_argument( "n1 and n2 must be positive" );
-        }
-        long long max_edges = static_cast < long long >( n1 ) * n2;
-        if ( directional ) max_edges *= 2;
-        m = static_cast < int >( std::min( static_cast < long long >( m ) , max_edges ) );
-        std::vector < Edge > edges;
-        edges.reserve( m );
-        if ( m <= max_edges / 2 ) {
-            // ϡ裺
-            std::unordered_set < long long > edge_set;
-            std::uniform_int_distribution < int > dist1( 0 , n1 - 1 );
-            std::uniform_int_distribution < int > dist2( n1 , n1 + n2 - 1 );
-            std::bernoulli_distribution coin( 0.5 );
-            while ( static_cast < int >( edges.size() ) < m ) {
-                int u = dist1( rng_64 );
-                int v = dist2( rng_64 );
-                if ( directional && coin( rng_64 ) ) {
-                    std::swap( u , v );
-                }
-                long long key = static_cast < long long >( u ) * ( n1 + n2 ) + v;
-                if ( !edge_set.count( key ) ) {
-                    edge_set.insert( key );
-                    edges.push_back( { u , v } );
-                }
+        /**
+         * @brief ι c[0..m)  {-1, 0, 1}^mȫΪ 0ʹ  c[i]base^(m-1-i)  0 (mod mod)m = 2^k
+         * @details ÿְѴذֵϲֵСĴȡֵС 0 ɹ
+         * @return ɹʱϵʧܷؿ
+         */
+        std::vector < int > treeAttack( std::uint64_t base , std::uint64_t mod , std::size_t m ) {
+            struct Cluster {
+                std::uint64_t value;
+                std::vector < std::size_t > positions;
+            };
+            std::vector < int > coef( m , 1 );
+            std::vector < Cluster > clusters( m );
+            std::uint64_t power = 1 % mod;
+            for ( std::size_t i = m ; i-- > 0 ; ) {
+                clusters[i] = { power , { i } };
+                power = mulMod( power , base , mod );
             }
-        } else {
-            // ܣöٺѡ
-            std::vector < std::pair < int , int > > all_edges;
-            for ( int u = 0 ; u < n1 ; ++u ) {
-                for ( int v = n1 ; v < n1 + n2 ; ++v ) {
-                    all_edges.push_back( { u , v } );
-                    if ( directional ) {
-                        all_edges.push_back( { v , u } );
-                    }
+            while ( !clusters.empty() ) {
+                for ( const Cluster &c : clusters ) {
+                    if ( c.value != 0 ) continue;
+                    std::vector < int > result( m , 0 );
+                    for ( std::size_t p : c.positions ) result[p] = coef[p];
+                    return result;
                 }
+                if ( clusters.size() == 1 ) break;
+                std::sort( clusters.begin() , clusters.end() , []( const Cluster &x , const Cluster &y ) {
+                    return x.value < y.value;
+                } );
+                std::vector < Cluster > merged;
+                merged.reserve( clusters.size() / 2 );
+                for ( std::size_t j = 0 ; j + 1 < clusters.size() ; j += 2 ) {
+                    Cluster &low = clusters[j] , &high = clusters[j + 1];
+                    for ( std::size_t p : low.positions ) coef[p] = -coef[p];
+                    high.positions.insert( high.positions.end() , low.positions.begin() , low.positions.end() );
+                    merged.push_back( { high.value - low.value , std::move( high.positions ) } );
+                }
+                clusters = std::move( merged );
             }
-            // Ҳȡǰ m 
-            for ( size_t i = all_edges.size() - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < size_t > dist( 0 , i );
-                std::swap( all_edges[i] , all_edges[dist( rng_64 )] );
-            }
-            for ( int i = 0 ; i < m ; ++i ) {
-                edges.push_back( { all_edges[i].first , all_edges[i].second } );
-            }
+            return {};
         }
-        std::vector < std::pair < int , int > > e;
-        for ( const auto &[u,v] : edges ) {
-            e.emplace_back( u + base , v + base );
+
+        /**
+         * @brief  s / t Ϊ"ַ"ϵƴӣc = 1 ʱ (t, s)c = -1 ʱ (s, t)c = 0 ʱ (s, s)
+         * @details h(s') - h(t') = (h(t) - h(s)) c[i]B^(m-1-i) B Ϊ base^|s|
+         */
+        std::pair < std::string , std::string > combineBlocks( const std::string &s , const std::string &t ,
+                                                               const std::vector < int > &coef ) {
+            std::string x , y;
+            x.reserve( s.size() * coef.size() );
+            y.reserve( s.size() * coef.size() );
+            for ( int c : coef ) {
+                x += c == 1 ? t : s;
+                y += c == -1 ? t : s;
+            }
+            return { std::move( x ) , std::move( y ) };
         }
-        return e;
     }
 
-    std::vector < std::pair < int , int > > RANDOMGRAPH::random_dag_graph( int n , int m , int base ) {
-        if ( n <= 0 ) throw std::invalid_argument( "n must be positive" );
-        long long max_edges = static_cast < long long >( n ) * ( n - 1 ) / 2;
-        m = static_cast < int >( std::min( static_cast < long long >( m ) , max_edges ) );
-        std::vector < Edge > edges;
-        edges.reserve( m );
-        // 
-        std::vector < int > topo_order( n );
-        std::iota( topo_order.begin() , topo_order.end() , 0 );
-        for ( int i = n - 1 ; i > 0 ; --i ) {
-            std::uniform_int_distribution < int > dist( 0 , i );
-            std::swap( topo_order[i] , topo_order[dist( rng_64 )] );
-        }
-        // ӳ䣺topo_pos[v] = v еλ
-        std::vector < int > topo_pos( n );
-        for ( int i = 0 ; i < n ; ++i ) {
-            topo_pos[topo_order[i]] = i;
-        }
-        // ɱߣ֤ u  v ֮ǰ
-        struct PairHash {
-            size_t operator()( const std::pair < int , int > &p ) const {
-                return std::hash < long long >()(
-                    static_cast < long long >( p.first ) * 1000000007LL + p.second
-                );
-            }
-        };
-        std::unordered_set < std::pair < int , int > , PairHash > edge_set;
-        if ( m <= max_edges / 2 ) {
-            // ϡͼ
-            int attempts = 0;
-            int max_attempts = m * 100 + 10000;
-            while ( static_cast < int >( edges.size() ) < m && attempts < max_attempts ) {
-                std::uniform_int_distribution < int > dist( 0 , n - 1 );
-                int a = dist( rng_64 );
-                int b = dist( rng_64 );
-                if ( a == b ) {
-                    ++attempts;
+    std::pair < std::string , std::string > RANDOMSTRING::anti_hash_strings( std::size_t n ,
+                                                                             const std::vector < PolyHash > &hashes ,
+                                                                             char a , char b ) {
+        if ( a == b ) throw std::invalid_argument( "a and b must be different" );
+        // ڵĻģڳ˻ʱ CRT ϲһ飺һιĿ鳤̵ö
+        std::vector < PolyHash > stages;
+        for ( const PolyHash &h : hashes ) {
+            if ( h.mod == 1 ) throw std::invalid_argument( "mod must not be 1" );
+            if ( h.mod != 0 && !stages.empty() ) {
+                PolyHash &last = stages.back();
+                if ( last.mod != 0 && std::gcd( last.mod , h.mod ) == 1 &&
+                     last.mod <= static_cast < std::uint64_t >( LLONG_MAX ) / h.mod ) {
+                    // base  last.base (mod last.mod)base  h.base (mod h.mod)
+                    long long inv , unused;
+                    exgcd( static_cast < long long >( last.mod % h.mod ) , static_cast < long long >( h.mod ) ,
+                           inv , unused );
+                    const std::uint64_t p = h.mod;
+                    const std::uint64_t inv_mod = static_cast < std::uint64_t >(
+                        ( inv % static_cast < long long >( p ) + static_cast < long long >( p ) ) %
+                        static_cast < long long >( p ) );
+                    const std::uint64_t b1 = last.base % last.mod , b2 = h.base % p;
+                    const std::uint64_t k = mulMod( ( b2 + p - b1 % p ) % p , inv_mod , p );
+                    last = { b1 + last.mod * k , last.mod * p };
                     continue;
                 }
-                // ȷߵķ
-                int u = ( topo_pos[a] < topo_pos[b] ) ? a : b;
-                int v = ( topo_pos[a] < topo_pos[b] ) ? b : a;
-                std::pair < int , int > e = { u , v };
-                if ( !edge_set.count( e ) ) {
-                    edge_set.insert( e );
-                    edges.push_back( { u , v } );
-                }
-                ++attempts;
             }
-        } else {
-            // ͼöпܵı
-            std::vector < std::pair < int , int > > all_edges;
-            for ( int i = 0 ; i < n ; ++i ) {
-                for ( int j = i + 1 ; j < n ; ++j ) {
-                    all_edges.push_back( { topo_order[i] , topo_order[j] } );
+            stages.push_back( h );
+        }
+        std::string s( 1 , a ) , t( 1 , b );
+        auto check_length = [&]( std::size_t blocks ) {
+            if ( s.size() > n / blocks ) throw std::invalid_argument( "n too small for the collision" );
+        };
+        for ( const auto &[base , mod] : stages ) {
+            //  s / t ΪַʱĵЧ
+            const std::uint64_t block_base = powMod( base , s.size() , mod );
+            std::vector < int > coef;
+            if ( mod == 0 && ( base == 0 || ( block_base & 1 ) ) ) {
+                // Thue-Morse (1 - B^(2^j))  B  j < 11 ʱۻ 2^64 
+                constexpr std::size_t BLOCKS = std::size_t( 1 ) << 11;
+                check_length( BLOCKS );
+                coef.resize( BLOCKS );
+                for ( std::size_t i = 0 ; i < BLOCKS ; ++i ) coef[i] = __builtin_parityll( i ) ? -1 : 1;
+            } else if ( mod == 0 ) {
+                // żB^e  0 (mod 2^64)ֻڵһ鲻ͬ
+                const std::size_t v = block_base == 0 ? 64 : __builtin_ctzll( block_base );
+                const std::size_t blocks = ( 64 + v - 1 ) / v + 1;
+                check_length( blocks );
+                coef.assign( blocks , 0 );
+                coef[0] = 1;
+            } else {
+                for ( std::size_t blocks = 2 ; coef.empty() ; blocks *= 2 ) {
+                    check_length( blocks );
+                    coef = treeAttack( block_base , mod , blocks );
                 }
             }
-            // Ҳȡǰ m 
-            for ( size_t i = all_edges.size() - 1 ; i > 0 ; --i ) {
-                std::uniform_int_distribution < size_t > dist( 0 , i );
-                std::swap( all_edges[i] , all_edges[dist( rng_64 )] );
-            }
-            for ( int i = 0 ; i < m && i < static_cast < int >( all_edges.size() ) ; ++i ) {
-                edges.push_back( { all_edges[i].first , all_edges[i].second } );
-            }
-        }
-        // ұߵ˳
-        for ( int i = static_cast < int >( edges.size() ) - 1 ; i > 0 ; --i ) {
-            std::uniform_int_distribution < int > dist( 0 , i );
-            std::swap( edges[i] , edges[dist( rng_64 )] );
-        }
-        std::vector < std::pair < int , int > > e;
-        for ( const auto &[u,v] : edges ) {
-            e.emplace_back( u + base , v + base );
+            std::tie( s , t ) = combineBlocks( s , t , coef );
         }
-        return e;
+        check_length( 1 );
+        // ײλãǰַͬ
+        const std::size_t offset = static_cast < std::size_t >( detail::bounded( rng_64 , n - s.size() + 1 ) );
+        const Alphabet pad( std::string { a , b } );
+        std::string x( n , '\0' );
+        pad.fill( x.data() , offset );
+        pad.fill( x.data() + offset + s.size() , n - offset - s.size() );
+        std::string y = x;
+        std::memcpy( x.data() + offset , s.data() , s.size() );
+        std::memcpy( y.data() + offset , t.data() , t.size() );
+        return { std::move( x ) , std::move( y ) };
     }
 
     long long QuickPow( long long x , long long pow , long long p ) {
@@ -1000,6 +3050,122 @@ namespace AMPLE_RAND {
         return std::ofstream( str.c_str() , std::ios::out | std::ios::binary );
     }
 
+    OutputSink::OutputSink( std::size_t capacity ) : buffer( std::max < std::size_t >( capacity , 64 ) ) ,
+                                                      capacity( std::max < std::size_t >( capacity , 64 ) ) {
+        syncFormat();
+    }
+
+    OutputSink::~OutputSink() {
+        close();
+    }
+
+    bool OutputSink::open( const std::string &path ) {
+        close();
+        used = 0;
+        failed = false;
+        file = std::fopen( path.c_str() , "wb" );
+        if ( file == nullptr ) return false;
+        // л壬ر stdio ο
+        std::setvbuf( file , nullptr , _IONBF , 0 );
+        // ڴģʽ»ָΪ̶С
+        if ( buffer.size() != capacity ) {
+            buffer.assign( capacity , '\0' );
+            buffer.shrink_to_fit();
+        }
+        return true;
+    }
+
+    bool OutputSink::close() {
+        if ( file == nullptr ) return !failed;
+        flush();
+        if ( std::fclose( file ) != 0 ) failed = true;
+        file = nullptr;
+        return !failed;
+    }
+
+    void OutputSink::flush() {
+        if ( file == nullptr || used == 0 ) return;
+        if ( std::fwrite( buffer.data() , 1 , used , file ) != used ) failed = true;
+        used = 0;
+    }
+
+    void OutputSink::makeRoom( std::size_t n ) {
+        if ( file != nullptr ) {
+            flush();
+            if ( buffer.size() >= n ) return;
+        }
+        // ڴģʽ򵥴д볬
+        buffer.resize( std::max( buffer.size() * 2 , used + n ) );
+    }
+
+    OutputSink &OutputSink::write( const char *s , std::size_t n ) {
+        if ( buffer.size() - used >= n ) {
+            std::memcpy( buffer.data() + used , s , n );
+            used += n;
+            return *this;
+        }
+        if ( file != nullptr ) {
+            flush();
+            // ƹֱд
+            if ( n >= buffer.size() ) {
+                if ( std::fwrite( s , 1 , n , file ) != n ) failed = true;
+                return *this;
+            }
+        } else {
+            makeRoom( n );
+        }
+        std::memcpy( buffer.data() + used , s , n );
+        used += n;
+        return *this;
+    }
+
+    OutputSink &OutputSink::writeFloating( double value ) {
+        //  printf  %.*g / %.*f / %.*e һ£ iostream Ӧʽ
+        const int precision = static_cast < int >( formatter.precision() );
+        const auto format = static_cast < std::chars_format >( floatMode );
+        char tmp[64];
+        auto res = std::to_chars( tmp , tmp + sizeof( tmp ) , value , format , precision );
+        if ( res.ec != std::errc() ) return formatted( value );
+        return write( tmp , static_cast < std::size_t >( res.ptr - tmp ) );
+    }
+
+    void OutputSink::syncFormat() {
+        const std::ios_base::fmtflags f = formatter.flags();
+        const bool widthSet = formatter.width() != 0;
+        plainInteger = !widthSet && ( f & std::ios_base::basefield ) == std::ios_base::dec &&
+                       !( f & std::ios_base::showpos );
+        if ( widthSet || ( f & ( std::ios_base::showpos | std::ios_base::showpoint | std::ios_base::uppercase ) ) ) {
+            floatMode = -1;
+            return;
+        }
+        const std::ios_base::fmtflags field = f & std::ios_base::floatfield;
+        if ( field == std::ios_base::fmtflags( 0 ) ) {
+            floatMode = static_cast < int >( std::chars_format::general );
+        } else if ( field == std::ios_base::fixed ) {
+            floatMode = static_cast < int >( std::chars_format::fixed );
+        } else if ( field == std::ios_base::scientific ) {
+            floatMode = static_cast < int >( std::chars_format::scientific );
+        } else {
+            // hexfloat  formatter
+            floatMode = -1;
+        }
+    }
+
+    OutputSink &OutputSink::operator<<( std::ostream &( *manip )( std::ostream & ) ) {
+        // std::endl Ȳݷܲͳһ formatter ת
+        manip( formatter );
+        const std::string s = formatter.str();
+        formatter.str( std::string() );
+        syncFormat();
+        return write( s.data() , s.size() );
+    }
+
+    OutputSink &OutputSink::operator<<( std::ios_base &( *manip )( std::ios_base & ) ) {
+        manip( formatter );
+        syncFormat();
+        return *this;
+    }
+
     GradientOptResult compute_gradient_opt( int total_files , int file_id , bool zero_indexed ,
                                             GradientStrategy strategy , double sharpness ) {
         // 
@@ -1175,6 +3341,8 @@ namespace AMPLE_RAND {
         GradientScaleGenerator gen( Limit );
         // ʼӰ
         auto opts = getAllGradientOpts( endIndex - startIndex + 1 , strategy );
+        // ¼ӣʱ AMPLE_RAND_SEED  setSeed 
+        printSeed();
         for ( int index = startIndex ; index <= endIndex ; ++index ) {
             std::ofstream writeInputFile =
                     openOutputFileStream( dataFilePath + std::to_string( index ) + inFileType );
@@ -1182,8 +3350,11 @@ namespace AMPLE_RAND {
                 std::cout << "ɹļ " << index << "\n";
                 auto [DATAL , DATAR] = gen.getGradientRange( index );
                 double OFFSET = opts[index - startIndex];
-                int _ = random( 1 , multiple , OFFSET );
-                while ( _ -- ) {
+                // ļÿݷֱ֣Ӱ
+                rng_64.seed( deriveSeed( index ) );
+                int cases = random( 1 , multiple , OFFSET );
+                for ( int k = 1 ; k <= cases ; ++k ) {
+                    rng_64.seed( deriveSeed( index , k ) );
                     solve( DATAL , DATAR , OFFSET );
                     INPUT_DATA.push_back( ins.str() );
                     OUTPUT_DATA.push_back( ous.str() );
@@ -1221,4 +3392,113 @@ namespace AMPLE_RAND {
         }
         return true;
     }
+
+    bool batchGenerateFiles( int startIndex , int endIndex ,
+                             std::function < void( long long , long long , double ) > solve ,
+                             long long Limit , OutputSink &ins , OutputSink &ous ,
+                             int multiple , GradientStrategy strategy ) {
+        // ʼݶ
+        GradientScaleGenerator gen( Limit );
+        // ʼӰ
+        auto opts = getAllGradientOpts( endIndex - startIndex + 1 , strategy );
+        // ¼ӣʱ AMPLE_RAND_SEED  setSeed 
+        printSeed();
+        for ( int index = startIndex ; index <= endIndex ; ++index ) {
+            const std::string fileName = dataFilePath + std::to_string( index );
+            if ( !ins.open( fileName + inFileType ) || !ous.open( fileName + outFileType ) ) {
+                ins.close();
+                ous.close();
+                std::cerr << "дļʧ " << index << "\n";
+                return false;
+            }
+            std::cout << "ɹļ " << index << "\n";
+            auto [DATAL , DATAR] = gen.getGradientRange( index );
+            double OFFSET = opts[index - startIndex];
+            // ļÿݷֱ֣Ӱ
+            rng_64.seed( deriveSeed( index ) );
+            int cases = random( 1 , multiple , OFFSET );
+            for ( int k = 1 ; k <= cases ; ++k ) {
+                rng_64.seed( deriveSeed( index , k ) );
+                solve( DATAL , DATAR , OFFSET );
+            }
+            // ļرգܶ·
+            const bool inputDone = ins.close();
+            const bool outputDone = ous.close();
+            if ( !inputDone || !outputDone ) {
+                std::cerr << "дļʧ " << index << "\n";
+                return false;
+            }
+            std::cout << "дɹ " << index << "\n";
+        }
+        return true;
+    }
+
+    bool batchGenerateFilesParallel( int startIndex , int endIndex ,
+                                     std::function < void( long long , long long , double ,
+                                                           OutputSink & , OutputSink & ) > solve ,
+                                     long long Limit , int multiple , GradientStrategy strategy ,
+                                     unsigned threads , unsigned long long seed ) {
+        if ( startIndex > endIndex ) return true;
+        const int fileCount = endIndex - startIndex + 1;
+        if ( threads == 0 ) threads = std::max( 1u , std::thread::hardware_concurrency() );
+        threads = std::min( threads , static_cast < unsigned >( fileCount ) );
+        // ݶӰֻ̹߳
+        const GradientScaleGenerator gen( Limit );
+        const auto opts = getAllGradientOpts( fileCount , strategy );
+        std::cout << "AMPLE_RAND_SEED=" << seed << " | ߳ " << threads << "\n";
+
+        std::atomic < int > nextIndex( startIndex );
+        std::atomic < bool > success( true );
+        std::mutex logMutex;
+        std::exception_ptr firstError = nullptr;
+
+        auto worker = [&]() {
+            // ļ֮ѾУļڵĴģҲٿ̣߳߳޹أ
+            setShuffleThreads( 1 );
+            // ÿ̶߳
+            OutputSink ins , ous;
+            for ( int index = nextIndex ++ ; index <= endIndex && success ; index = nextIndex ++ ) {
+                try {
+                    const std::string fileName = dataFilePath + std::to_string( index );
+                    if ( !ins.open( fileName + inFileType ) || !ous.open( fileName + outFileType ) ) {
+                        ins.close();
+                        ous.close();
+                        std::lock_guard < std::mutex > lock( logMutex );
+                        std::cerr << "дļʧ " << index << "\n";
+                        success = false;
+                        break;
+                    }
+                    // ļֻ (seed, index) 
+                    rng_64.seed( deriveSeedFrom( seed , index ) );
+                    auto [DATAL , DATAR] = gen.getGradientRange( index );
+                    double OFFSET = opts[index - startIndex];
+                    int cases = random( 1 , multiple , OFFSET );
+                    for ( int k = 1 ; k <= cases ; ++k ) {
+                        rng_64.seed( deriveSeedFrom( seed , index , k ) );
+                        solve( DATAL , DATAR , OFFSET , ins , ous );
+                    }
+                    const bool inputDone = ins.close();
+                    const bool outputDone = ous.close();
+                    std::lock_guard < std::mutex > lock( logMutex );
+                    if ( !inputDone || !outputDone ) {
+                        std::cerr << "дļʧ " << index << "\n";
+                        success = false;
+                    } else {
+                        std::cout << "дɹ " << index << "\n";
+                    }
+                } catch ( ... ) {
+                    std::lock_guard < std::mutex > lock( logMutex );
+                    if ( !firstError ) firstError = std::current_exception();
+                    success = false;
+                }
+            }
+        };
+
+        std::vector < std::thread > pool;
+        pool.reserve( threads );
+        for ( unsigned t = 0 ; t < threads ; ++t ) pool.emplace_back( worker );
+        for ( auto &th : pool ) th.join();
+        if ( firstError ) std::rethrow_exception( firstError );
+        return success;
+    }
 }
@@ -10,8 +10,243 @@
 #include <bits/stdc++.h>
 
 namespace AMPLE_RAND {
+    namespace detail {
+        /**
+         * @brief 64 位 × 64 位 → 128 位乘法
+         * @param a 乘数
+         * @param b 乘数
+         * @param hi 结果高 64 位
+         * @return 结果低 64 位
+         */
+        inline std::uint64_t mul128( std::uint64_t a , std::uint64_t b , std::uint64_t &hi ) {
+#if defined( __SIZEOF_INT128__ )
+            const unsigned __int128 p = static_cast < unsigned __int128 >( a ) * b;
+            hi = static_cast < std::uint64_t >( p >> 64 );
+            return static_cast < std::uint64_t >( p );
+#else
+            const std::uint64_t a_lo = a & 0xFFFFFFFFULL , a_hi = a >> 32;
+            const std::uint64_t b_lo = b & 0xFFFFFFFFULL , b_hi = b >> 32;
+            const std::uint64_t ll = a_lo * b_lo , lh = a_lo * b_hi , hl = a_hi * b_lo , hh = a_hi * b_hi;
+            const std::uint64_t mid = ( ll >> 32 ) + ( lh & 0xFFFFFFFFULL ) + ( hl & 0xFFFFFFFFULL );
+            hi = hh + ( lh >> 32 ) + ( hl >> 32 ) + ( mid >> 32 );
+            return ( mid << 32 ) | ( ll & 0xFFFFFFFFULL );
+#endif
+        }
+
+        /**
+         * @brief Lemire 无偏有界整数采样：返回 [0, bound) 上的均匀整数
+         * @param g 输出完整 64 位的随机数引擎
+         * @param bound 上界 (> 0)
+         *
+         * 一次 64×64 乘法取高位，仅当低位落入 2^64 mod bound 的拒绝区间时重抽（概率 < bound / 2^64），
+         * 只在罕见的拒绝分支中做一次取模
+         */
+        template < typename URBG > inline std::uint64_t bounded( URBG &g , std::uint64_t bound ) {
+            std::uint64_t hi;
+            std::uint64_t lo = mul128( static_cast < std::uint64_t >( g() ) , bound , hi );
+            if ( lo < bound ) {
+                const std::uint64_t threshold = ( 0 - bound ) % bound;
+                while ( lo < threshold ) {
+                    lo = mul128( static_cast < std::uint64_t >( g() ) , bound , hi );
+                }
+            }
+            return hi;
+        }
+
+        /**
+         * @brief 返回 [0, range] 上的均匀整数（range 可为 2^64 - 1）
+         */
+        template < typename URBG > inline std::uint64_t bounded_inclusive( URBG &g , std::uint64_t range ) {
+            if ( range == ~std::uint64_t( 0 ) ) return static_cast < std::uint64_t >( g() );
+            return bounded( g , range + 1 );
+        }
+
+        /**
+         * @brief 引擎是否输出完整的 64 位（Lemire 采样的前提）
+         */
+        template < typename URBG > constexpr bool is_full_64bit() {
+            using G = std::remove_reference_t < URBG >;
+            return G::min() == 0 && G::max() == ~std::uint64_t( 0 );
+        }
+
+        inline std::uint64_t rotl64( std::uint64_t x , int k ) {
+            return ( x << k ) | ( x >> ( ( 64 - k ) & 63 ) );
+        }
+
+        inline std::uint64_t rotr64( std::uint64_t x , int k ) {
+            return ( x >> k ) | ( x << ( ( 64 - k ) & 63 ) );
+        }
+    }
+
+    /**
+     * @brief splitmix64 引擎：8 字节状态，速度最快，统计质量足够出题使用
+     */
+    class SplitMix64 {
+        public:
+            using result_type = std::uint64_t;
+            static constexpr const char *name = "splitmix64";
+
+            explicit SplitMix64( result_type seed = 0 ) { this->seed( seed ); }
+
+            void seed( result_type seed ) { state_ = seed; }
+
+            result_type operator()() {
+                std::uint64_t z = ( state_ += 0x9E3779B97F4A7C15ULL );
+                z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+                z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+                return z ^ ( z >> 31 );
+            }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return ~result_type( 0 ); }
+
+        private:
+            std::uint64_t state_;
+    };
+
+    /**
+     * @brief xoshiro256** 引擎：32 字节状态，周期 2^256 - 1
+     */
+    class Xoshiro256StarStar {
+        public:
+            using result_type = std::uint64_t;
+            static constexpr const char *name = "xoshiro256**";
+
+            explicit Xoshiro256StarStar( result_type seed = 0 ) { this->seed( seed ); }
+
+            void seed( result_type seed ) {
+                // 用 splitmix64 展开种子，保证状态不全为 0
+                SplitMix64 sm( seed );
+                for ( auto &w : s_ ) w = sm();
+            }
+
+            result_type operator()() {
+                const std::uint64_t result = detail::rotl64( s_[1] * 5 , 7 ) * 9;
+                const std::uint64_t t = s_[1] << 17;
+                s_[2] ^= s_[0];
+                s_[3] ^= s_[1];
+                s_[1] ^= s_[2];
+                s_[0] ^= s_[3];
+                s_[2] ^= t;
+                s_[3] = detail::rotl64( s_[3] , 45 );
+                return result;
+            }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return ~result_type( 0 ); }
+
+        private:
+            std::uint64_t s_[4];
+    };
+
+    /**
+     * @brief PCG64 引擎（XSL-RR 128/64）：128 位 LCG 状态 + 置换输出
+     */
+    class Pcg64 {
+        public:
+            using result_type = std::uint64_t;
+            static constexpr const char *name = "pcg64";
+
+            explicit Pcg64( result_type seed = 0 ) { this->seed( seed ); }
+
+            void seed( result_type seed ) {
+                SplitMix64 sm( seed );
+                hi_ = lo_ = 0;
+                inc_hi_ = sm();
+                inc_lo_ = sm() | 1; // 增量必须为奇数
+                step();
+                const std::uint64_t init_hi = sm();
+                const std::uint64_t init_lo = sm();
+                add( init_hi , init_lo );
+                step();
+            }
+
+            result_type operator()() {
+                step();
+                return detail::rotr64( hi_ ^ lo_ , static_cast < int >( hi_ >> 58 ) );
+            }
+
+            static constexpr result_type min() { return 0; }
+            static constexpr result_type max() { return ~result_type( 0 ); }
+
+        private:
+            // state = state * MULT + inc（模 2^128）
+            void step() {
+                constexpr std::uint64_t MULT_HI = 0x2360ED051FC65DA4ULL;
+                constexpr std::uint64_t MULT_LO = 0x4385DF649FCCF645ULL;
+                std::uint64_t carry;
+                const std::uint64_t lo = detail::mul128( lo_ , MULT_LO , carry );
+                hi_ = carry + lo_ * MULT_HI + hi_ * MULT_LO;
+                lo_ = lo;
+                add( inc_hi_ , inc_lo_ );
+            }
+
+            void add( std::uint64_t hi , std::uint64_t lo ) {
+                lo_ += lo;
+                hi_ += hi + ( lo_ < lo ? 1 : 0 );
+            }
+
+            std::uint64_t hi_ , lo_ , inc_hi_ , inc_lo_;
+    };
+
+    /*
+     * 全局随机数引擎类型（编译期选择）
+     * 编译时定义 AMPLE_RAND_ENGINE 即可替换，例如：
+     *   g++ -DAMPLE_RAND_ENGINE=AMPLE_RAND::Xoshiro256StarStar ...
+     * 可选：std::mt19937_64（默认）、Xoshiro256StarStar、Pcg64、SplitMix64，
+     * 或任意满足 UniformRandomBitGenerator 且提供 seed(uint64) 的 64 位引擎
+     * 注意：所有翻译单元（包括 DataGenerator.cpp）必须使用相同的定义
+     */
+#ifdef AMPLE_RAND_ENGINE
+    using RandomEngine = AMPLE_RAND_ENGINE;
+#else
+    using RandomEngine = std::mt19937_64;
+#endif
+    static_assert( RandomEngine::min() == 0 && RandomEngine::max() == ~std::uint64_t( 0 ) ,
+                   "RandomEngine 必须输出完整的 64 位随机数" );
+
     // 声明：告诉编译器这个变量在别处定义了
-    extern std::mt19937_64 rng_64;
+    // 每个线程持有独立的引擎，并行生成时互不干扰
+    extern thread_local RandomEngine rng_64;
+
+    /**
+     * @brief 设置主种子，并用它重置当前线程的 rng_64
+     * @param seed 主种子
+     *
+     * @note 未调用时主种子取环境变量 AMPLE_RAND_SEED，若未设置则随机选取；
+     *       random / RANDOMTREE / RANDOMGRAPH / RandomBasic.shuffle 均使用 rng_64，因此都受其控制
+     */
+    void setSeed( unsigned long long seed );
+
+    /**
+     * @brief 获取当前主种子
+     * @return 主种子
+     */
+    unsigned long long getSeed();
+
+    /**
+     * @brief 由主种子派生子种子（splitmix64 混合）
+     * @param seed 主种子
+     * @param fileIndex 文件编号
+     * @param caseIndex 文件内的数据组编号（0 表示文件级）
+     * @return 子种子，只由 (seed, fileIndex, caseIndex) 决定
+     */
+    unsigned long long deriveSeedFrom( unsigned long long seed , unsigned long long fileIndex ,
+                                       unsigned long long caseIndex = 0 );
+
+    /**
+     * @brief 由当前主种子派生子种子
+     * @param fileIndex 文件编号
+     * @param caseIndex 文件内的数据组编号（0 表示文件级）
+     * @return 子种子
+     */
+    unsigned long long deriveSeed( unsigned long long fileIndex , unsigned long long caseIndex = 0 );
+
+    /**
+     * @brief 打印当前主种子，便于复现整套数据
+     * @param os 输出流
+     */
+    void printSeed( std::ostream &os = std::cout );
 
     /**
      * @brief 随机整数生成函数
@@ -37,25 +272,344 @@ namespace AMPLE_RAND {
      */
     double randomDouble( double l , double r , double opt = 1.0 );
 
+    namespace detail {
+        // 批量生成时每块的样本数（栈上缓冲区，常驻 L1）
+        constexpr std::size_t BATCH_CHUNK = 256;
+
+        /**
+         * @brief 用 rng_64 生成 n 个 [0, 1) 上的均匀实数（53 位精度）
+         */
+        void uniform_unit_batch( double *out , std::size_t n );
+
+        /**
+         * @brief 原地计算 x[i] = x[i]^e，x[i] ∈ [0, 1)（正规数或 0），e > 0
+         *
+         * - e = 1 / 2 / 3 / 4 / 0.5 / 0.25 走快速路径（乘法或 sqrt），误差 ≤ 2 ulp
+         *   （x^3、x^4 与 sqrt(sqrt x) 经过不止一次舍入，不保证与 std::pow 逐位相同）
+         * - 其余 e 使用基于 exp/log 多项式的向量化核（GCC/Clang 向量扩展，SSE2/AVX/NEON 通用，
+         *   其它编译器退化为同一算法的标量版本）
+         *   相对误差 ≤ 2^-52 · (8 + 2·|e·ln x|)，即 |e·ln x| ≤ 40 时 < 2e-14；
+         *   结果小于 2^-1021 时置为 0
+         */
+        void pow_batch( double *x , std::size_t n , double e );
+
+        /**
+         * @brief 单个样本的幂变换 x^e，e = 1 / 2 / 0.5 时走精确快速路径，否则调用 std::pow
+         */
+        double pow_unit( double x , double e );
+
+        /**
+         * @brief 将 y ∈ [0, 1) 映射到整数区间 [l, l + range]
+         * @param l 左端点
+         * @param range r - l（无符号，避免大区间溢出）
+         * @param y 单位区间上的样本
+         */
+        inline long long unit_to_range( long long l , unsigned long long range , double y ) {
+            unsigned long long offset;
+            if ( range < ( 1ULL << 53 ) ) {
+                // range + 1 可被 double 精确表示，直接用 double 计算
+                offset = static_cast < unsigned long long >( y * static_cast < double >( range + 1 ) );
+            } else {
+                offset = static_cast < unsigned long long >(
+                    static_cast < long double >( y ) * ( static_cast < long double >( range ) + 1.0L ) );
+            }
+            // 双边界保护（舍入可能得到 range + 1）
+            offset = std::min( offset , range );
+            return static_cast < long long >( static_cast < unsigned long long >( l ) + offset );
+        }
+    }
+
+    /**
+     * @brief 批量随机整数填充 [first, last)
+     * @tparam ForwardIt 前向迭代器，元素类型可由 long long 赋值
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     * @param l 左区间端点
+     * @param r 右区间端点
+     * @param opt 偏移因子（含义同 random）
+     *
+     * 参数校验、1/opt 只计算一次；偏移分布按块生成，块内变换为无分支的紧凑循环
+     * 时间复杂度: O(n)
+     */
+    template < typename ForwardIt > void randomFill( ForwardIt first , ForwardIt last ,
+                                                      long long l , long long r , double opt = 1.0 ) {
+        if ( l > r ) std::swap( l , r );
+        if ( l == r ) {
+            std::fill( first , last , l );
+            return;
+        }
+        if ( opt <= 0.0 ) throw std::invalid_argument( "opt must be positive" );
+        const unsigned long long range = static_cast < unsigned long long >( r ) -
+                                         static_cast < unsigned long long >( l );
+        if ( std::fabs( opt - 1.0 ) <= 1e-8 ) {
+            for ( ; first != last ; ++first ) {
+                *first = static_cast < long long >( static_cast < unsigned long long >( l ) +
+                                                    detail::bounded_inclusive( rng_64 , range ) );
+            }
+            return;
+        }
+        const double inv_opt = 1.0 / opt;
+        double buf[detail::BATCH_CHUNK];
+        auto remaining = static_cast < std::size_t >( std::distance( first , last ) );
+        while ( remaining > 0 ) {
+            const std::size_t k = std::min( remaining , detail::BATCH_CHUNK );
+            detail::uniform_unit_batch( buf , k );
+            detail::pow_batch( buf , k , inv_opt );
+            for ( std::size_t i = 0 ; i < k ; ++i , ++first ) {
+                *first = detail::unit_to_range( l , range , buf[i] );
+            }
+            remaining -= k;
+        }
+    }
+
+    /**
+     * @brief 批量随机整数填充容器（vector, array, deque 等）
+     */
+    template <
+        typename Container ,
+        typename = decltype(std::declval < Container & >().begin()) ,
+        typename = decltype(std::declval < Container & >().end()) >
+    void randomFill( Container &c , long long l , long long r , double opt = 1.0 ) {
+        randomFill( c.begin() , c.end() , l , r , opt );
+    }
+
+    /**
+     * @brief 批量随机整数填充 C 风格静态数组
+     */
+    template < typename T , std::size_t N > void randomFill( T ( &arr )[N] , long long l , long long r ,
+                                                             double opt = 1.0 ) {
+        randomFill( std::begin( arr ) , std::end( arr ) , l , r , opt );
+    }
+
+    /**
+     * @brief 生成长度为 n 的随机整数数组
+     * @param n 数组长度
+     * @param l 左区间端点
+     * @param r 右区间端点
+     * @param opt 偏移因子（含义同 random）
+     * @return vector< long long > 随机数组
+     */
+    std::vector < long long > randomArray( std::size_t n , long long l , long long r , double opt = 1.0 );
+
+    /**
+     * @brief 批量随机实数填充 [first, last)
+     * @tparam ForwardIt 前向迭代器，元素类型可由 double 赋值
+     * @param first 起始迭代器
+     * @param last 结束迭代器
+     * @param l 左区间端点
+     * @param r 右区间端点
+     * @param opt 偏移因子（含义同 randomDouble）
+     *
+     * 幂变换由 detail::pow_batch 按块向量化完成
+     */
+    template < typename ForwardIt > void randomDoubleFill( ForwardIt first , ForwardIt last ,
+                                                            double l , double r , double opt = 1.0 ) {
+        if ( l > r ) std::swap( l , r );
+        if ( opt <= 0.0 ) throw std::invalid_argument( "opt must be positive" );
+        const double inv_opt = 1.0 / opt;
+        const double width = r - l;
+        double buf[detail::BATCH_CHUNK];
+        auto remaining = static_cast < std::size_t >( std::distance( first , last ) );
+        while ( remaining > 0 ) {
+            const std::size_t k = std::min( remaining , detail::BATCH_CHUNK );
+            detail::uniform_unit_batch( buf , k );
+            detail::pow_batch( buf , k , inv_opt );
+            for ( std::size_t i = 0 ; i < k ; ++i , ++first ) *first = l + width * buf[i];
+            remaining -= k;
+        }
+    }
+
+    /**
+     * @brief 批量随机实数填充容器
+     */
+    template <
+        typename Container ,
+        typename = decltype(std::declval < Container & >().begin()) ,
+        typename = decltype(std::declval < Container & >().end()) >
+    void randomDoubleFill( Container &c , double l , double r , double opt = 1.0 ) {
+        randomDoubleFill( c.begin() , c.end() , l , r , opt );
+    }
+
+    /**
+     * @brief 生成长度为 n 的随机实数数组
+     * @param n 数组长度
+     * @param l 左区间端点
+     * @param r 右区间端点
+     * @param opt 偏移因子（含义同 randomDouble）
+     * @return vector< double > 随机数组
+     */
+    std::vector < double > randomDoubleArray( std::size_t n , double l , double r , double opt = 1.0 );
+
+    /**
+     * @brief 预处理好的字符集：构造一次，反复批量生成随机字符
+     * @details 等概率字符集按 16 位一段切分每个 64 位随机数（每次得到 4 个字符，逐段 Lemire 拒绝，结果严格均匀），
+     *          字符数为 2 的幂时直接按位截取（如 2 个字符时每次 64 个）；带权字符集使用 Walker 别名表，每个字符一次随机数
+     * @note 字符可以重复，重复的字符按出现次数计算概率；字符数不超过 65536
+     */
+    class Alphabet {
+        public:
+            /**
+             * @brief 等概率字符集
+             * @param chars 字符集，如 charLowerCase
+             */
+            explicit Alphabet( std::string_view chars );
+
+            /**
+             * @brief 带权字符集：字符 chars[i] 的概率正比于 weights[i]
+             * @param chars 字符集
+             * @param weights 权值（非负，总和为正），长度与 chars 相同
+             */
+            Alphabet( std::string_view chars , const std::vector < double > &weights );
+
+            /**
+             * @brief 随机生成 n 个字符写入 out
+             */
+            void fill( char *out , std::size_t n ) const;
+
+            /**
+             * @brief 生成长度为 n 的随机字符串
+             * @param allowZero 是否允许前导零（含义同 randomString）
+             */
+            std::string generate( std::size_t n , bool allowZero = false ) const;
+
+            /**
+             * @brief 随机生成一个字符
+             */
+            char sample() const;
+
+            std::size_t size() const {
+                return chars_.size();
+            }
+
+            const std::string &chars() const {
+                return chars_;
+            }
+
+        private:
+            std::string chars_;
+            // 等概率：字符数为 2 的幂时的位数，否则为 -1
+            int bits_ = -1;
+            // 带权：别名表，prob_[i] 为保留 chars_[i] 的概率（乘以 2^32）
+            std::vector < std::uint64_t > prob_;
+            std::vector < std::uint32_t > alias_;
+
+            // 首字符不能为 '0' 时重抽
+            char sampleNonZero() const;
+    };
+
     /**
      * @brief 随机字符串生成器
      * @param n 字符串长度
      * @param chars 随机字符串内容
      * @param allowZero 是否允许字符串中出现前导零 默认不允许
      * @return 随机字符串
+     *
+     * @note 反复使用同一字符集时，构造一个 Alphabet 并调用 generate / fill 可省去每次的预处理
      */
-    std::string randomString( int n , std::string chars , bool allowZero = false );
+    std::string randomString( int n , const std::string &chars , bool allowZero = false );
 
     /**
      * @brief 随机字符串生成器
      * @param chars 字符串数组内容
      * @return 字符串数组中随机字符串
      */
-    std::string randomString( std::vector < std::string > chars );
+    std::string randomString( const std::vector < std::string > &chars );
 
     /**
      * 随机基础函数类
      */
+    /**
+     * @brief 设置当前线程中 RandomBasic.shuffle / randomPermutation 并行打乱使用的线程数
+     * @param threads 线程数，0（默认）表示硬件线程数，1 表示不开新线程
+     * @note 打乱结果只由种子决定，与线程数无关；batchGenerateFilesParallel 的工作线程自动设为 1
+     */
+    void setShuffleThreads( unsigned threads );
+
+    unsigned getShuffleThreads();
+
+    namespace detail {
+        // 元素数不少于此值时 RandomBasic.shuffle / randomPermutation 使用分桶并行打乱
+        constexpr std::size_t PARALLEL_SHUFFLE_THRESHOLD = std::size_t( 1 ) << 22;
+
+        /**
+         * @brief 把 [0, count) 的任务分给 threads 个线程（0 表示硬件线程数），每个任务调用一次 task(i)
+         */
+        template < typename Task > void parallelFor( std::size_t count , unsigned threads , Task &&task ) {
+            if ( threads == 0 ) threads = std::max( 1u , std::thread::hardware_concurrency() );
+            threads = static_cast < unsigned >( std::min < std::size_t >( threads , count ) );
+            if ( threads <= 1 ) {
+                for ( std::size_t i = 0 ; i < count ; ++i ) task( i );
+                return;
+            }
+            std::atomic < std::size_t > next( 0 );
+            auto worker = [&] {
+                for ( std::size_t i ; ( i = next++ ) < count ; ) task( i );
+            };
+            std::vector < std::thread > pool;
+            pool.reserve( threads - 1 );
+            for ( unsigned t = 1 ; t < threads ; ++t ) pool.emplace_back( worker );
+            worker();
+            for ( std::thread &th : pool ) th.join();
+        }
+
+        /**
+         * @brief 分桶并行打乱：out[0, n) 得到 source(0), ..., source(n-1) 的均匀随机排列
+         * @details 1. 输入分成若干块，每块用独立引擎给每个元素随机选一个桶，统计各桶大小；
+         *          2. 前缀和得到每块在每个桶中的写入位置，再用同一引擎重放一遍，把元素写入所属桶；
+         *          3. 每个桶（约 2^18 个元素，常驻 L2）用独立引擎做 Fisher-Yates。
+         *          桶大小服从多项分布、桶内为均匀排列，因此整体是均匀随机排列。
+         *          每个块 / 桶使用独立的 xoshiro256** 引擎（局部对象，比 thread_local 的 rng_64 快），
+         *          种子只由 seed 与其编号决定，结果与线程数无关
+         * @param source source(i) 返回第 i 个元素（按块顺序调用，同一 i 只调用一次）
+         * @param seed 种子
+         * @param threads 线程数，0 表示硬件线程数
+         */
+        template < typename T , typename Source >
+        void scatterShuffle( T *out , std::size_t n , Source &&source , std::uint64_t seed , unsigned threads ) {
+            const std::size_t buckets = std::clamp < std::size_t >( ( n >> 18 ) + 1 , 2 , 4096 );
+            const std::size_t blocks = std::clamp < std::size_t >( ( n >> 16 ) + 1 , 1 , 256 );
+            auto block_begin = [&]( std::size_t j ) {
+                return static_cast < std::size_t >( static_cast < unsigned long long >( n ) / blocks * j +
+                                                    static_cast < unsigned long long >( n ) % blocks * j / blocks );
+            };
+            // offset[j * buckets + b]：块 j 写入桶 b 的下一个位置
+            std::vector < std::size_t > offset( blocks * buckets , 0 );
+            parallelFor( blocks , threads , [&]( std::size_t j ) {
+                Xoshiro256StarStar engine( deriveSeedFrom( seed , j , 0 ) );
+                std::size_t *count = offset.data() + j * buckets;
+                for ( std::size_t i = block_begin( j ) , end = block_begin( j + 1 ) ; i < end ; ++i ) {
+                    ++count[bounded( engine , buckets )];
+                }
+            } );
+            std::vector < std::size_t > bucket_begin( buckets + 1 );
+            std::size_t sum = 0;
+            for ( std::size_t b = 0 ; b < buckets ; ++b ) {
+                bucket_begin[b] = sum;
+                for ( std::size_t j = 0 ; j < blocks ; ++j ) {
+                    const std::size_t count = offset[j * buckets + b];
+                    offset[j * buckets + b] = sum;
+                    sum += count;
+                }
+            }
+            bucket_begin[buckets] = sum;
+            parallelFor( blocks , threads , [&]( std::size_t j ) {
+                Xoshiro256StarStar engine( deriveSeedFrom( seed , j , 0 ) );
+                std::size_t *next = offset.data() + j * buckets;
+                for ( std::size_t i = block_begin( j ) , end = block_begin( j + 1 ) ; i < end ; ++i ) {
+                    out[next[bounded( engine , buckets )]++] = source( i );
+                }
+            } );
+            parallelFor( buckets , threads , [&]( std::size_t b ) {
+                Xoshiro256StarStar engine( deriveSeedFrom( seed , b , 1 ) );
+                T *first = out + bucket_begin[b];
+                for ( std::size_t i = bucket_begin[b + 1] - bucket_begin[b] ; i > 1 ; --i ) {
+                    const std::size_t j = static_cast < std::size_t >( bounded( engine , i ) );
+                    if ( j != i - 1 ) std::swap( first[i - 1] , first[j] );
+                }
+            } );
+        }
+    }
+
     class RANDOMBASIC {
         public:
             /**
@@ -67,7 +621,8 @@ namespace AMPLE_RAND {
              * @param rng_64 随机数引擎
              *
              * 时间复杂度: O(n)
-             * 空间复杂度: O(1)
+             * 空间复杂度: O(1)；n >= 2^22 时改用 detail::scatterShuffle 分桶并行打乱（需要元素可默认构造），
+             *            额外内存 O(n)，只从 rng_64 取一个种子，结果与线程数（setShuffleThreads）无关
              */
             template <
                 typename RandomIt ,
@@ -82,12 +637,37 @@ namespace AMPLE_RAND {
                 const diff_t n = last - first;
                 // 边界情况：0 或 1 个元素无需打乱
                 if ( n <= 1 ) return;
+                using value_t = typename std::iterator_traits < RandomIt >::value_type;
+                if constexpr ( std::is_default_constructible_v < value_t > &&
+                               std::is_move_assignable_v < value_t > ) {
+                    const auto size = static_cast < std::size_t >( n );
+                    if ( size >= detail::PARALLEL_SHUFFLE_THRESHOLD ) {
+                        std::uint64_t seed;
+                        if constexpr ( detail::is_full_64bit < URBG >() ) {
+                            seed = rng_64();
+                        } else {
+                            seed = std::uniform_int_distribution < std::uint64_t >()( rng_64 );
+                        }
+                        std::unique_ptr < value_t[] > buffer( new value_t[size] );
+                        detail::scatterShuffle( buffer.get() , size , [&]( std::size_t i ) {
+                            return std::move( first[static_cast < diff_t >( i )] );
+                        } , seed , getShuffleThreads() );
+                        std::move( buffer.get() , buffer.get() + size , first );
+                        return;
+                    }
+                }
                 // Fisher-Yates 算法（从后向前）
                 // 不变量：[i+1, n) 范围内的元素已经确定
                 for ( diff_t i = n - 1 ; i > 0 ; --i ) {
                     // 在 [0, i] 中均匀随机选择
-                    std::uniform_int_distribution < diff_t > dist( 0 , i );
-                    const diff_t j = dist( rng_64 );
+                    diff_t j;
+                    if constexpr ( detail::is_full_64bit < URBG >() ) {
+                        // Lemire 乘法采样，无需每次构造分布对象
+                        j = static_cast < diff_t >( detail::bounded( rng_64 , static_cast < std::uint64_t >( i ) + 1 ) );
+                    } else {
+                        std::uniform_int_distribution < diff_t > dist( 0 , i );
+                        j = dist( rng_64 );
+                    }
                     // 避免自交换（微优化）
                     if ( i != j ) {
                         std::swap( first[i] , first[j] );
@@ -169,6 +749,171 @@ namespace AMPLE_RAND {
 
     static RANDOMBASIC RandomBasic;
 
+    /**
+     * @brief 整数的分块接收器：流式生成函数每次交付一块数（指针, 个数），指针只在回调期间有效
+     */
+    using ValueChunkSink = std::function < void( const long long * , std::size_t ) >;
+
+    // 整数流式生成默认的分块大小（个）
+    constexpr std::size_t VALUE_CHUNK_SIZE = std::size_t( 1 ) << 16;
+
+    /**
+     * @brief 随机排列 base, base + 1, ..., base + n - 1
+     * @param n 元素个数 (>= 0)
+     * @param base 最小值
+     * @param threads 线程数，0 表示沿用 setShuffleThreads 的设置
+     * @return vector< int > 随机排列
+     *
+     * @note n >= 2^22 时使用分桶并行打乱（不需要先 iota），结果只由种子与 n 决定，与线程数无关
+     */
+    std::vector < int > randomPermutation( int n , int base = 1 , unsigned threads = 0 );
+
+    /**
+     * @brief 从 [l, r] 中随机选取 k 个互不相同的整数，顺序随机
+     * @details 哈希集合拒绝采样，期望每个数不超过 2 次抽样；k 超过区间一半时改为随机排除补集。
+     *          时间 O(k)，内存 O(k)，与 r - l 无关（如 r = 1e18）
+     * @throws std::invalid_argument l > r、k > r - l + 1 或区间长度为 2^64 时
+     */
+    std::vector < long long > randomDistinct( std::size_t k , long long l , long long r );
+
+    /**
+     * @brief 流式版本的 randomDistinct：数按块交给 sink，不保存结果
+     * @note 仍需 O(k) 内存记录已选的数
+     */
+    void streamDistinct( std::size_t k , long long l , long long r , const ValueChunkSink &sink ,
+                         std::size_t chunk_size = VALUE_CHUNK_SIZE );
+
+    /**
+     * @brief 从 [l, r] 中随机选取 k 个互不相同的整数，按升序返回（每个 k 元子集等概率）
+     * @details 区间长度不超过 2^53 时使用 Vitter Method D 顺序抽样：直接抽取相邻两个选中数之间的间隔，
+     *          按升序逐个生成，期望时间 O(k)，额外内存 O(1)；更长的区间双精度无法精确表示间隔，
+     *          改为哈希抽样后排序，时间 O(k log k)，内存 O(k)
+     * @throws std::invalid_argument 同 randomDistinct
+     */
+    std::vector < long long > randomSortedSample( std::size_t k , long long l , long long r );
+
+    /**
+     * @brief 流式版本的 randomSortedSample：按升序分块交给 sink
+     */
+    void streamSortedSample( std::size_t k , long long l , long long r , const ValueChunkSink &sink ,
+                             std::size_t chunk_size = VALUE_CHUNK_SIZE );
+
+    /**
+     * @brief 随机组合：把 total 拆成 k 个有序整数之和，每部分 ∈ [min_part, max_part]
+     * @param total 总和
+     * @param k 部分数量（0 时要求 total = 0）
+     * @param min_part 每部分下界
+     * @param max_part 每部分上界
+     * @param variance 方差控制 [0, 1]：
+     *                 - 0: 尽量平均，各部分相差至多 1，多出的单位随机分给若干部分（不是固定给前几个）
+     *                 - 1: 在满足上下界的所有组合中均匀随机
+     *                 - 中间值：先把 (1 - variance) 比例的余量平均分配，其余按 1 的方式随机分配
+     * @return vector< long long > 各部分大小，顺序随机
+     *
+     * @details 扣除下界后用隔板法：在 S + k - 1 个位置中按升序抽取 k - 1 个隔板（randomSortedSample 的
+     *          Method D，期望 O(k)）。有上界时在"余量"与"距上界的空位"两者中较小的一侧拒绝采样，仍严格均匀；
+     *          上界过紧、多次拒绝仍失败时改为把超出上界的部分截断后重新分给未满的部分（近似均匀）
+     * @note 需要无序划分（如各组大小）时对结果排序即可
+     * @throws std::invalid_argument min_part > max_part、variance 不在 [0, 1] 或 total 不在 [k·min_part, k·max_part] 时
+     */
+    std::vector < long long > randomComposition( long long total , std::size_t k , long long min_part = 1 ,
+                                                 long long max_part = LLONG_MAX , double variance = 1.0 );
+
+    /**
+     * @brief 边的分块接收器：流式生成函数每次交付一块边（指针, 条数），指针只在回调期间有效
+     */
+    using EdgeChunkSink = std::function < void( const std::pair < int , int > * , std::size_t ) >;
+
+    // 流式生成默认的分块大小（条）
+    constexpr std::size_t EDGE_CHUNK_SIZE = std::size_t( 1 ) << 16;
+
+    /**
+     * @brief 带权边集（结构数组）：第 i 条边为 u[i] → v[i]，边权 w[i]
+     */
+    struct WeightedEdges {
+        std::vector < int > u , v;
+        std::vector < long long > w;
+
+        std::size_t size() const {
+            return u.size();
+        }
+
+        void reserve( std::size_t n ) {
+            u.reserve( n );
+            v.reserve( n );
+            w.reserve( n );
+        }
+
+        void push_back( int a , int b ) {
+            u.push_back( a );
+            v.push_back( b );
+        }
+    };
+
+    /**
+     * @brief 边权分布，供 random_weighted_* 系列函数使用
+     * @details 边集生成完成后一次性批量填充边权（uniform / biased 走 randomFill 的分块路径）
+     */
+    class WeightDistribution {
+        public:
+            enum class Kind { Uniform , SmallRange , Adversarial };
+
+            /**
+             * @brief [l, r] 上的随机边权，opt 含义同 random（opt = 1 为均匀分布）
+             */
+            static WeightDistribution uniform( long long l , long long r , double opt = 1.0 ) {
+                return WeightDistribution( Kind::Uniform , l , r , opt );
+            }
+
+            /**
+             * @brief 偏移分布的边权，等价于 uniform( l , r , opt )
+             */
+            static WeightDistribution biased( long long l , long long r , double opt ) {
+                return WeightDistribution( Kind::Uniform , l , r , opt );
+            }
+
+            /**
+             * @brief 小值域 [l, r]（r - l < 65536）上的均匀边权，大量相同边权，用于 0-1 BFS、卡比较函数等
+             * @note 每个 64 位随机数切成 4 段 16 位使用（逐段拒绝采样，结果严格均匀）
+             */
+            static WeightDistribution small_range( long long l , long long r ) {
+                return WeightDistribution( Kind::SmallRange , l , r , 1.0 );
+            }
+
+            /**
+             * @brief 针对 Dijkstra / SPFA 的边权：随两端在生成结构中的位置之差单调增大（同一差值内带随机扰动）
+             * @details 位置相近的边便宜、相距远的边贵，最短路倾向于走大量“短边”，最短路树很深，
+             *          SPFA 会先以错误的距离访问大量节点再反复松弛，堆优化 Dijkstra 的入堆次数也接近边数
+             * @note random_weighted_* 按编号打乱前的位置（树的生成顺序、图的骨架位置、DAG 的拓扑序）计算，
+             *       与是否打乱编号无关；直接调用 fill 且不提供 position 时按编号差计算
+             */
+            static WeightDistribution adversarial( long long l , long long r ) {
+                return WeightDistribution( Kind::Adversarial , l , r , 1.0 );
+            }
+
+            /**
+             * @brief 为 count 条边填充边权
+             * @param u v 边的端点（已加 base）
+             * @param w 输出的边权
+             * @param n 节点数量（adversarial 用于归一化位置差）
+             * @param position 可选，position[x - base] 为节点 x 的位置（adversarial 按位置差计算）；为空时按编号差计算
+             * @param base 节点偏移量，仅与 position 一起使用
+             */
+            void fill( const int *u , const int *v , long long *w , std::size_t count , int n ,
+                       const int *position = nullptr , int base = 0 ) const;
+
+            Kind kind() const {
+                return type;
+            }
+
+        private:
+            Kind type;
+            long long l , r;
+            double opt;
+
+            WeightDistribution( Kind type , long long l , long long r , double opt );
+    };
+
     /**
      * 随机生成树类
      */
@@ -197,6 +942,19 @@ namespace AMPLE_RAND {
             std::vector < std::pair < int , int > > random_tree( int n , int base = 1 , int root = 0 ,
                                                                  double rho = 2.0 , bool vertices_rand = true );
 
+            /**
+             * @brief 流式生成随机树：边按块交给 sink，不保存边集
+             * @param n 节点数量 (>= 1)
+             * @param sink 边的分块接收器
+             * @param base root rho vertices_rand 同 random_tree（rho 很大/很小时即链/星形）
+             * @param chunk_size 每块边数
+             *
+             * @note 额外内存 O(n)（节点编号排列与父亲数组），与边集无关；vertices_rand = false 时为 O(chunk_size)
+             *       vertices_rand = true 时边按子节点编号升序给出，与 random_tree 一致
+             */
+            void stream_tree( int n , const EdgeChunkSink &sink , int base = 1 , int root = 0 , double rho = 2.0 ,
+                              bool vertices_rand = true , std::size_t chunk_size = EDGE_CHUNK_SIZE );
+
             /**
              * @brief 生成随机树
              *
@@ -213,13 +971,79 @@ namespace AMPLE_RAND {
              *                               （此时 root 必须为 0）
              *                      - true:  随机打乱编号，但 root 保持不变
              *
-             * @return vector< int > 父亲数组
+             * @return vector< int > 父亲数组，parent[v] 为节点 v + base 的父节点编号（已加 base），根节点为 -1
              *
              * @note 节点编号从 1 开始，即 [1, n]
              */
             std::vector < int > random_tree_parent( int n , int base = 1 , int root = 0 , double rho = 2.0 ,
                                                     bool vertices_rand = true );
 
+            /**
+             * @brief 生成带权随机树
+             * @param weights 边权分布，如 WeightDistribution::uniform( 1 , 1e9 )
+             * @param 其余参数同 random_tree
+             * @return WeightedEdges 带权边集（u 为父节点，v 为子节点）
+             */
+            WeightedEdges random_weighted_tree( int n , const WeightDistribution &weights , int base = 1 ,
+                                                int root = 0 , double rho = 2.0 , bool vertices_rand = true );
+
+            /**
+             * @brief 将随机树的边集直接写入调用方提供的缓冲区（random_tree 的无分配版本）
+             * @param edges 长度至少为 n - 1 的缓冲区
+             * @param 其余参数同 random_tree
+             *
+             * @note 不申请任何额外内存：节点编号排列直接存放在各条边的子节点一侧，父节点从中读取，
+             *       最后原地按子节点编号升序重排
+             */
+            void fill_random_tree( std::pair < int , int > *edges , int n , int base = 1 , int root = 0 ,
+                                   double rho = 2.0 , bool vertices_rand = true );
+
+            /**
+             * @brief 将随机树的父亲数组直接写入调用方提供的缓冲区（random_tree_parent 的无拷贝版本）
+             * @param parent 长度至少为 n 的缓冲区
+             * @param 其余参数同 random_tree_parent
+             *
+             * @note vertices_rand = true 时额外需要一个 n 个 int 的编号排列，否则不申请额外内存
+             */
+            void fill_random_tree_parent( int *parent , int n , int base = 1 , int root = 0 , double rho = 2.0 ,
+                                          bool vertices_rand = true );
+
+            /**
+             * @brief 由 Prüfer 序列生成均匀随机带标号树
+             *
+             * @param n             节点数量 (>= 1)
+             * @param base          节点偏移量，默认是 1
+             * @param root          根节点编号 [0, n-1]
+             * @param opt           Prüfer 序列元素的分布参数（同 random 的 opt）
+             *                      - opt = 1:  均匀随机带标号树（n^(n-2) 棵树等概率），期望深度 O(√n)
+             *                      - opt ≠ 1:  序列集中在少数标号上，这些节点度数很大，树更浅更“星形”
+             * @param vertices_rand 是否随机打乱节点编号（opt ≠ 1 时决定大度数节点是否集中在大/小编号上；
+             *                      opt = 1 时树本身已与编号无关）
+             *
+             * @return vector< pair< int, int > > 边集数组（父节点, 子节点），顺序随机
+             *
+             * @note 节点编号从 1 开始，即 [1, n]
+             * @note O(n) 线性解码，可直接生成 1e7 个节点的树
+             */
+            std::vector < std::pair < int , int > > random_prufer_tree( int n , int base = 1 , int root = 0 ,
+                                                                        double opt = 1.0 ,
+                                                                        bool vertices_rand = true );
+
+            /**
+             * @brief 由 Prüfer 序列生成均匀随机带标号树，返回父亲数组（格式同 random_tree_parent）
+             * @param 参数同 random_prufer_tree
+             */
+            std::vector < int > random_prufer_tree_parent( int n , int base = 1 , int root = 0 , double opt = 1.0 ,
+                                                           bool vertices_rand = true );
+
+            /**
+             * @brief Prüfer 序列 O(n) 解码
+             * @param prufer 长度为 n - 2 的序列，元素在 [0, n-1] 中
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（父节点, 子节点），以 n - 1 为根，按解码顺序排列
+             */
+            std::vector < std::pair < int , int > > prufer_decode( const std::vector < int > &prufer , int base = 1 );
+
             /**
              * @brief 随机生成树链
              * @param n 节点数量 (>= 1)
@@ -241,177 +1065,577 @@ namespace AMPLE_RAND {
              * @param vertices_rand     是否随机打乱节点编号
              * @return vector< pair< int, int > > 边集数组
              *
-             * @note 节点编号从 1 开始，即 [1, n]
+             * @note 节点编号从 1 开始，即 [1, n]
+             */
+            std::vector < std::pair < int , int > > random_tree_star( int n , int base = 1 , int root = 0 ,
+                                                                      bool vertices_rand = true );
+
+            /**
+             * @brief 毛毛虫：长为 spine_length 的主链，其余节点均匀随机挂在主链节点上
+             * @param n 节点数量 (>= 1)
+             * @param spine_length 主链节点数 [1, n]，根为主链一端
+             * @param base root vertices_rand 同 random_tree
+             * @return vector< pair< int, int > > 边集数组
+             *
+             * @note 节点编号从 1 开始，即 [1, n]；以下特殊形态树均为 O(n)
+             */
+            std::vector < std::pair < int , int > > random_caterpillar( int n , int spine_length , int base = 1 ,
+                                                                        int root = 0 , bool vertices_rand = true );
+
+            /**
+             * @brief 扫帚：从根出发长为 handle_length 的链（柄），其余节点全部挂在柄的末端
+             * @param n 节点数量 (>= 1)
+             * @param handle_length 柄的节点数 [1, n]（含根）
+             * @param base root vertices_rand 同 random_tree
+             * @return vector< pair< int, int > > 边集数组
+             */
+            std::vector < std::pair < int , int > > random_broom( int n , int handle_length , int base = 1 ,
+                                                                  int root = 0 , bool vertices_rand = true );
+
+            /**
+             * @brief 链 + 菊花：根下挂一条长为 chain_length 的链，其余节点都是根的叶子
+             * @param n 节点数量 (>= 1)
+             * @param chain_length 链的节点数 [0, n-1]（不含根）
+             * @param base root vertices_rand 同 random_tree
+             * @return vector< pair< int, int > > 边集数组
+             */
+            std::vector < std::pair < int , int > > random_chain_star( int n , int chain_length , int base = 1 ,
+                                                                       int root = 0 , bool vertices_rand = true );
+
+            /**
+             * @brief 完全 k 叉树（按层填满，最后一层从左到右）
+             * @param n 节点数量 (>= 1)
+             * @param k 每个节点的最大子节点数 (>= 1，k = 1 即链)
+             * @param base root vertices_rand 同 random_tree
+             * @return vector< pair< int, int > > 边集数组
+             */
+            std::vector < std::pair < int , int > > random_kary_tree( int n , int k , int base = 1 , int root = 0 ,
+                                                                      bool vertices_rand = true );
+
+            /**
+             * @brief 最大度数受限的随机树：每个新节点在度数未满的节点中均匀选择父节点
+             * @param n 节点数量 (>= 1)
+             * @param max_degree 每个节点的最大度数（含连向父节点的边，>= 2）
+             * @param base root vertices_rand 同 random_tree
+             * @return vector< pair< int, int > > 边集数组
+             */
+            std::vector < std::pair < int , int > > random_degree_bounded_tree( int n , int max_degree , int base = 1 ,
+                                                                                int root = 0 ,
+                                                                                bool vertices_rand = true );
+
+            /**
+             * @brief       生成随机二叉树
+             * @param n     节点数量 (>= 1)
+             * @param base  节点偏移量，默认是 1
+             * @param root  根节点编号 [0, n-1]
+             * @param rho   深度控制参数（同随机树）
+             *                      - rho → 0:  浅而宽
+             *                      - rho = 1:  均匀随机
+             *                      - rho → ∞:  深而窄（趋向链）
+             * @param vertices_rand 是否随机打乱节点编号
+             * @param balance       平衡度控制 [0, 1]
+             *                      每个新节点以概率 balance 挂到当前最浅的空槽位上，否则按 rho 选择槽位
+             *                      - 0: 完全由 rho 决定
+             *                      - 1: 逐层填满，得到完全二叉树形态
+             * @return vector< pair< int, int > > 边集数组
+             *
+             * @note 节点编号从 1 开始，即 [1, n]
+             * @note 时间复杂度 O(n log n)；rho = 1 且 balance = 0 时为 O(n)
+             */
+            std::vector < std::pair < int , int > > random_binary_tree( int n , int base = 1 , int root = 0 ,
+                                                                        double rho = 1.0 , bool vertices_rand = true ,
+                                                                        double balance = 0.0 );
+
+            /**
+             * @brief 生成随机森林
+             * @param n 节点数量 (>= 1)
+             * @param num_trees 树数量 [1,n]
+             * @param base 节点偏移量，默认是 1
+             * @param rho 树深度控制参数（同随机树）
+             * @param vertices_rand 是否随机打乱节点编号
+             * @param size_variance 树大小的方差控制 [0, 1]，含义同 randomComposition 的 variance
+             *                      - 0: 所有树大小尽量相等（相差至多 1）
+             *                      - 1: 树大小为 n 的均匀随机组合
+             * @return vector< pair< int, int > > 边集数组
+             *
+             * @note 节点编号从 1 开始，即 [1, n]
+             */
+            std::vector < std::pair < int , int > > random_forest_tree( int n , int num_trees , int base = 1 ,
+                                                                        double rho = 1.0 , bool vertices_rand = true ,
+                                                                        double size_variance = 1.0 );
+    };
+
+    static RANDOMTREE RandomTree;
+
+    /**
+     * 随机生成图类
+     */
+    class RANDOMGRAPH {
+        private:
+            /**
+             * @brief 计算节点最小边数
+             * @param n 节点数量
+             * @param connected 是否连通
+             * @param directional 图的有向性
+             * @return 节点最小边数
+             */
+            static int compute_min_edges( int n , bool connected , bool directional ) {
+                if ( !connected || n <= 1 ) return 0;
+                if ( directional ) return n; // 有向连通：需要成环，至少 n 条边
+                return n - 1; // 无向连通：树，至少 n-1 条边
+            }
+
+            /**
+             * @brief 计算节点最大边数
+             * @param n 节点数量
+             * @param repeated_edges 是否重边
+             * @param self_rings 是否自环
+             * @param directional 是否有向
+             * @return 节点最大边数
+             */
+            static long long compute_max_edges( int n , bool repeated_edges , bool self_rings , bool directional ) {
+                if ( n <= 0 ) return 0;
+                if ( repeated_edges ) {
+                    // 允许重边时，设置一个实际上限
+                    return static_cast < long long >( n ) * n * 10;
+                }
+                long long base;
+                if ( directional ) {
+                    base = static_cast < long long >( n ) * ( n - 1 ); // 有向：n(n-1)
+                } else {
+                    base = static_cast < long long >( n ) * ( n - 1 ) / 2; // 无向：n(n-1)/2
+                }
+                if ( self_rings ) {
+                    base += n; // 加上 n 个自环
+                }
+                return base;
+            }
+
+        public:
+            /**
+             * 随机生成图（默认无向连通图（无重边、无自环））{点,边} 校验生成
+             * @param n 期望的节点数 (必须 > 0)
+             * @param m 期望的边数 (必须 >= 0)
+             * @param connected 是否要求连通（无向图为连通，有向图为弱连通）
+             * @param repeated_edges 是否允许重边
+             * @param self_rings 是否允许自环
+             * @param directional 是否为有向图
+             * @param opt 接近度参数 ∈ (0, +∞)
+             *                        - opt → 0:   返回值可能在合法范围内随机偏移
+             *                        - opt → ∞:   返回值尽可能接近输入的 (n, m)
+             *                        - opt = 1:   中等程度的随机性
+             *                        - opt = 10:  较小的随机波动（推荐默认值）
+             * @throws std::invalid_argument 如果参数完全不可行
+             * @return std::pair<int, int> {点,边}
+             */
+            std::pair < int , int > valid_nm( int n , int m , bool connected = true , bool repeated_edges = false ,
+                                              bool self_rings = false ,
+                                              bool directional = false , double opt = 10.0 );
+
+            /**
+             * @brief 生成随机图（默认无向连通图（无重边、无自环））
+             * @param n 节点数量
+             * @param m 边数
+             * @param connected 是否连通
+             * @param repeated_edges 是否允许重边
+             * @param self_rings 是否允许自环
+             * @param directional 是否为有向图
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组
+             *
+             * @note 节点编号从 1 开始，即 [1, n]
+             * @note 不允许重边时 m 超过最大边数则取满
+             * @note 在候选边的下标空间中采样，不枚举候选边：稀疏时拒绝采样 + 去重集合（位图或开放寻址哈希表），
+             *       稠密时在位图上选取或排除补集；时间与额外内存均为 O(m)（稠密时另需 n² / 8 字节位图）
+             */
+            std::vector < std::pair < int , int > > random_graph( int n , long long m , bool connected = true ,
+                                                                  bool repeated_edges = false ,
+                                                                  bool self_rings = false ,
+                                                                  bool directional = false ,
+                                                                  int base = 1 );
+
+            /**
+             * @brief 流式生成随机图：边按块交给 sink，不保存边集
+             * @param sink 边的分块接收器
+             * @param chunk_size 每块边数
+             * @param 其余参数同 random_graph
+             *
+             * @note 边只在块内随机打乱（连通骨架的边最先输出），需要全局随机顺序时使用 random_graph
+             * @note 额外内存：O(n) + 去重集合；去重集合为位图（n² / 8 字节，与 m 无关）与
+             *       开放寻址哈希表（约 12 字节/条）中较小者，允许重边时不需要去重集合
+             */
+            void stream_graph( int n , long long m , const EdgeChunkSink &sink , bool connected = true ,
+                               bool repeated_edges = false , bool self_rings = false , bool directional = false ,
+                               int base = 1 , std::size_t chunk_size = EDGE_CHUNK_SIZE );
+
+            /**
+             * @brief 生成带权随机图，边与边权在同一次调用中生成，不再需要逐条调用 random
+             * @param weights 边权分布
+             * @param 其余参数同 random_graph
+             * @return WeightedEdges 带权边集（顺序随机）
+             */
+            WeightedEdges random_weighted_graph( int n , long long m , const WeightDistribution &weights ,
+                                                 bool connected = true , bool repeated_edges = false ,
+                                                 bool self_rings = false , bool directional = false ,
+                                                 int base = 1 );
+
+            /**
+             * @brief 生成二分图
+             * @param n1 第一部分节点数
+             * @param n2 第二部分节点数
+             * @param m 边数（超过上限 n1·n2，有向时 2·n1·n2，则取满）
+             * @param directional 是否为有向图（每条边的方向随机）
+             * @param base 节点偏移量，默认是 1
+             * @param connected 是否连通（有向时为弱连通），先生成一棵跨两侧的随机生成树；m 少于 n1 + n2 - 1 时只输出生成树
+             * @return vector< pair< int, int > > 边集数组（顺序随机），无向时 first 属于第一部分
+             *
+             * @note 第一部分编号为 [base, base + n1)，第二部分为 [base + n1, base + n1 + n2)
+             * @note 在点对下标空间中采样（同 random_graph），不枚举点对；时间与额外内存 O(m)，
+             *       稠密时另需 n1·n2 / 8 字节位图
+             */
+            std::vector < std::pair < int , int > > random_binary_graph(
+                int n1 , int n2 , long long m , bool directional = false , int base = 1 , bool connected = false );
+
+            /**
+             * @brief 流式生成二分图：边按块（块内随机打乱）交给 sink，不保存边集
+             * @param sink 边的分块接收器
+             * @param chunk_size 每块边数
+             * @param 其余参数同 random_binary_graph
+             *
+             * @note 连通时生成树的边最先输出；额外内存为 O(n1 + n2) 加去重集合（同 stream_graph）
+             */
+            void stream_binary_graph( int n1 , int n2 , long long m , const EdgeChunkSink &sink ,
+                                      bool directional = false , int base = 1 , bool connected = false ,
+                                      std::size_t chunk_size = EDGE_CHUNK_SIZE );
+
+            /**
+             * @brief 生成度数受限的无向二分图
+             * @param n1 第一部分节点数
+             * @param n2 第二部分节点数
+             * @param m 边数（超过 min(n1·max_left_degree, n2·max_right_degree) 时取上限）
+             * @param max_left_degree 第一部分每个节点的最大度数 (>= 1)
+             * @param max_right_degree 第二部分每个节点的最大度数 (>= 1)
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（顺序随机），first 属于第一部分
+             *
+             * @details 在度数未满的两侧节点中随机配对，连续多次撞上已有的边时改为枚举剩余未满节点之间的空闲点对
+             * @note m 非常接近上限时，未满节点可能已两两相连，此时边数会略少于 m
+             */
+            std::vector < std::pair < int , int > > random_bounded_binary_graph(
+                int n1 , int n2 , long long m , int max_left_degree , int max_right_degree , int base = 1 );
+
+            /**
+             * @brief 生成 DAG（有向无环图）
+             * @param n 节点数量
+             * @param m 边数（超过 n(n-1)/2 时取满）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组，每条边 u → v 都满足 u 在随机拓扑序中位于 v 之前
+             *
+             * @note 节点编号从 1 开始，即 [1, n]
+             * @note 直接在拓扑序位置对的三角形下标空间中采样 m 个不同下标（稠密时排除补集），
+             *       时间与额外内存均为 O(m)，不枚举全部 n(n-1)/2 个点对
+             */
+            std::vector < std::pair < int , int > > random_dag_graph(
+                int n , long long m , int base = 1 );
+
+            /**
+             * @brief 流式生成 DAG：边按块（块内随机打乱）交给 sink，不保存边集
+             * @param sink 边的分块接收器
+             * @param chunk_size 每块边数
+             * @param 其余参数同 random_dag_graph
+             */
+            void stream_dag_graph( int n , long long m , const EdgeChunkSink &sink , int base = 1 ,
+                                   std::size_t chunk_size = EDGE_CHUNK_SIZE );
+
+            /**
+             * @brief 生成带权 DAG
+             * @param weights 边权分布
+             * @param 其余参数同 random_dag_graph
+             * @return WeightedEdges 带权边集（顺序随机）
+             */
+            WeightedEdges random_weighted_dag_graph( int n , long long m , const WeightDistribution &weights ,
+                                                     int base = 1 );
+
+            /**
+             * @brief 卡 SPFA / Bellman-Ford 的带权图：rows 行的网格 + 相邻列之间的捷径
+             * @param n 节点数量
+             * @param m 边数；少于网格边数时只输出网格，捷径最多取局部候选边的一半
+             * @param directional 是否为有向图（同 random_graph，每条边一条弧：网格弧背离网格角，捷径方向随机）
+             * @param base 节点偏移量，默认是 1
+             * @param rows 网格行数，0 表示自动（约 √n / 4）
+             * @param max_weight 边权上限，边权 ∈ [1, max_weight]
+             * @return WeightedEdges 带权边集（顺序随机）
+             *
+             * @note 节点按列优先编号且不打乱：base 号点为网格角，以它为源点时 SPFA 的松弛次数远超 O(m)
+             * @note 列内边权 ∈ [1, 10]，列间边与捷径边权 ∈ [1, max_weight]，无重边、无自环，O(n + m)
+             */
+            WeightedEdges anti_spfa_graph( int n , long long m , bool directional = false , int base = 1 ,
+                                           int rows = 0 , long long max_weight = 1000000000 );
+
+            /**
+             * @brief 网格图：rows 行 cols 列，每个格子与右侧、下方的格子相连
+             * @param rows 行数 (>= 1)
+             * @param cols 列数 (>= 1)
+             * @param vertices_rand 是否随机打乱节点编号（false 时按行优先编号，第 r 行第 c 列为 r * cols + c + base）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（2·rows·cols - rows - cols 条，顺序随机）
+             *
+             * @note 以下特殊结构图均为 O(n + m) 时间与内存，边的顺序随机，无向边两端顺序随机
+             */
+            std::vector < std::pair < int , int > > random_grid_graph( int rows , int cols , bool vertices_rand = true ,
+                                                                       int base = 1 );
+
+            /**
+             * @brief 仙人掌（每条边至多属于一个简单环）
+             * @param n 节点数量 (>= 1)
+             * @param cycle_ratio 每次新增的块为环的概率 [0, 1]，否则为一条桥边（0 即随机树）
+             * @param max_cycle_length 环长上限 (>= 3)，环长在 [3, max_cycle_length] 中均匀选取；0 表示自动（约 √n）
+             * @param vertices_rand 是否随机打乱节点编号
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组，边数为 n - 1 + 环数
+             *
+             * @details 从单个节点出发，每次均匀选择一个已有节点，在其上挂一个新环（其余节点均为新节点）或一条新边
+             */
+            std::vector < std::pair < int , int > > random_cactus_graph( int n , double cycle_ratio = 0.5 ,
+                                                                         int max_cycle_length = 0 ,
+                                                                         bool vertices_rand = true , int base = 1 );
+
+            /**
+             * @brief 轮图：1 个中心与 n - 1 个节点组成的环，中心与环上每个节点相连
+             * @param n 节点数量 (>= 4)
+             * @param vertices_rand 是否随机打乱节点编号（false 时 base 号点为中心，环按编号顺序）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（2(n - 1) 条）
+             */
+            std::vector < std::pair < int , int > > random_wheel_graph( int n , bool vertices_rand = true ,
+                                                                        int base = 1 );
+
+            /**
+             * @brief 完全图
+             * @param n 节点数量 (>= 1)
+             * @param directional 是否为有向图（有向时每对节点正反各一条边）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（n(n-1)/2 条，有向时 n(n-1) 条）
+             */
+            std::vector < std::pair < int , int > > random_complete_graph( int n , bool directional = false ,
+                                                                           int base = 1 );
+
+            /**
+             * @brief 随机函数图（内向基环森林）：每个节点恰有一条出边 i → f(i)，f(i) 均匀随机
+             * @param n 节点数量 (>= 1，不允许自环时 >= 2)
+             * @param self_rings 是否允许自环 f(i) = i
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组，第 i 条边为 (i + base, f(i) + base)，
+             *         即 edges[i].second 就是 f 数组
+             *
+             * @note 均匀随机函数的期望环上节点数约为 √(πn / 2)，最长链约 √n
+             */
+            std::vector < std::pair < int , int > > random_functional_graph( int n , bool self_rings = true ,
+                                                                             int base = 1 );
+
+            /**
+             * @brief 恰有 k 个强连通分量的有向图
+             * @param n 节点数量 (>= 1)
+             * @param m 边数；少于骨架边数时只输出骨架，超过上限时取满
+             * @param k 强连通分量个数 [1, n]
+             * @param vertices_rand 是否随机打乱节点编号（false 时各分量编号连续，且只有编号小的分量连向编号大的分量）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组
+             *
+             * @details n 个节点随机分成 k 组（大小均匀随机，至少为 1），组内先连一个有向环保证强连通，
+             *          其余边在“组内或连向拓扑序更靠后的组”的点对中无重复均匀采样，因此分量个数恰为 k
+             * @note 无重边、无自环；骨架边数为大小 >= 2 的各组大小之和
+             */
+            std::vector < std::pair < int , int > > random_scc_graph( int n , long long m , int k ,
+                                                                      bool vertices_rand = true , int base = 1 );
+
+            /**
+             * @brief 恰有 k 个点双连通分量（块）的无向连通图，桥本身算一个块
+             * @param n 节点数量 (>= 2)
+             * @param m 边数；少于骨架边数时只输出骨架，超过上限时取满
+             * @param k 点双连通分量个数 [1, n - 1]
+             * @param vertices_rand 是否随机打乱节点编号
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组
+             *
+             * @details 各块依次挂在一个已有节点（割点）上，块的大小 s_i >= 2 满足 Σ(s_i - 1) = n - 1：
+             *          大小为 2 的块是一条桥，更大的块先连一个哈密顿环保证点双连通，其余边只在块内无重复均匀采样
+             * @note 无重边、无自环；骨架边数为 Σ(s_i = 2 ? 1 : s_i)
+             */
+            std::vector < std::pair < int , int > > random_bcc_graph( int n , long long m , int k ,
+                                                                      bool vertices_rand = true , int base = 1 );
+
+            /**
+             * @brief 直径恰为 diameter 的无向连通图
+             * @param n 节点数量 (>= 1)
+             * @param m 边数；少于 n - 1 时只输出生成树，超过上限时取满
+             * @param diameter 直径 [1, n - 1]（n = 1 时为 0）；diameter = 1 时返回完全图（忽略 m）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（无重边、无自环，顺序随机）
+             *
+             * @details 先放一条长为 diameter 的路径 p_0 … p_D，节点 p_i 位于第 i 层；其余节点依次挂在一个随机的
+             *          可扩展节点下并继承它的层号，第 l 层节点离路径的距离不超过 min(l, D - l)。
+             *          其余边只连接层号相差不超过 1 的点对，因此 dist(p_0, p_D) = D 且任意两点距离不超过 D
+             * @note O(n + m log n)；diameter 很小时路径中部的节点度数很大
+             */
+            std::vector < std::pair < int , int > > random_diameter_graph( int n , long long m , int diameter ,
+                                                                           int base = 1 );
+
+            /**
+             * @brief 幂律度数序列：P(d) ∝ d^(-gamma)，d ∈ [min_degree, max_degree]，总和为偶数
+             * @param n 节点数量 (>= 1)
+             * @param gamma 幂律指数 (> 1)，常见取值 2 ~ 3
+             * @param min_degree 最小度数 (>= 1)
+             * @param max_degree 最大度数，0 表示 n - 1
+             * @return vector< int > 度数序列，可直接交给 random_configuration_graph
+             */
+            std::vector < int > power_law_degrees( int n , double gamma , int min_degree = 1 , int max_degree = 0 );
+
+            /**
+             * @brief 配置模型：按给定度数序列随机配对“半边”
+             * @param degrees 度数序列，degrees[i] 为节点 i + base 的度数，总和必须为偶数
+             * @param simple 是否删去自环与重边（删去后度数略小于给定值，度数分布基本不变）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（顺序随机）
+             *
+             * @note O(n + Σd)，不保证连通
              */
-            std::vector < std::pair < int , int > > random_tree_star( int n , int base = 1 , int root = 0 ,
-                                                                      bool vertices_rand = true );
+            std::vector < std::pair < int , int > > random_configuration_graph( const std::vector < int > &degrees ,
+                                                                                bool simple = true , int base = 1 );
 
             /**
-             * @brief       生成随机二叉树
-             * @param n     节点数量 (>= 1)
-             * @param base  节点偏移量，默认是 1
-             * @param root  根节点编号 [0, n-1]
-             * @param rho   深度控制参数（同随机树）
-             *                      - rho → 0:  浅而宽
-             *                      - rho = 1:  均匀随机
-             *                      - rho → ∞:  深而窄（趋向链）
-             * @param vertices_rand 是否随机打乱节点编号
-             * @param balance       平衡度控制 [0, 1]
-             *                      - 0: 完全随机选择左/右
-             *                      - 1: 尽量平衡（优先填充子节点少的方向）
-             * @return vector< pair< int, int > > 边集数组
+             * @brief Chung-Lu 随机图：边 (u, v) 独立地以 min(1, w_u·w_v / Σw) 的概率出现，节点 u 的期望度数约为 w_u
+             * @param weights 期望度数，weights[i] 对应节点 i + base
+             * @param connected 是否连通（把各连通块的代表节点随机连成一棵树，每个孤立块多一条边）
+             * @param base 节点偏移量，默认是 1
+             * @return vector< pair< int, int > > 边集数组（无重边、无自环，顺序随机）
              *
-             * @note 节点编号从 1 开始，即 [1, n]
+             * @note 按权值降序后用几何分布跳过不出现的点对（Miller-Hagberg），O(n log n + m)
              */
-            std::vector < std::pair < int , int > > random_binary_tree( int n , int base = 1 , int root = 0 ,
-                                                                        double rho = 1.0 , bool vertices_rand = true ,
-                                                                        int balance = 0 );
+            std::vector < std::pair < int , int > > random_chung_lu_graph( const std::vector < double > &weights ,
+                                                                           bool connected = false , int base = 1 );
 
             /**
-             * @brief 生成随机森林
+             * @brief 幂律随机图：期望度数按排名 i 取 c·(i + 1)^(-1/(gamma-1))，由 random_chung_lu_graph 生成
              * @param n 节点数量 (>= 1)
-             * @param num_trees 树数量 [1,n]
+             * @param m 期望边数（度数最大的若干节点被 n - 1 截断时实际边数略少）
+             * @param gamma 幂律指数 (> 1)，越小大度数节点越多
+             * @param connected 是否连通
              * @param base 节点偏移量，默认是 1
-             * @param rho 树深度控制参数（同随机树）
-             * @param vertices_rand 是否随机打乱节点编号
-             * @param size_variance 树大小的方差控制 [0, 1]
-             *                      - 0: 所有树大小尽量相等
-             *                      - 1: 树大小完全随机
              * @return vector< pair< int, int > > 边集数组
-             *
-             * @note 节点编号从 1 开始，即 [1, n]
              */
-            std::vector < std::pair < int , int > > random_forest_tree( int n , int num_trees , int base = 1 ,
-                                                                        double rho = 1.0 , bool vertices_rand = true ,
-                                                                        double size_variance = 1.0 );
+            std::vector < std::pair < int , int > > random_power_law_graph( int n , long long m , double gamma = 2.5 ,
+                                                                            bool connected = true , int base = 1 );
     };
 
-    static RANDOMTREE RandomTree;
+    static RANDOMGRAPH RandomGraph;
 
     /**
-     * 随机生成图类
+     * @brief 卡 std::unordered_map / unordered_set 的整数键：全部落入同一个桶
+     * @param count 键的数量
+     * @param max_value 键的上限，键 ∈ [1, max_value]
+     * @param bucket_count 目标桶数，0 表示自动：用当前标准库模拟插入 count 个元素后的桶数
+     *                     （libstdc++ 的素数表策略，如 1e5 个元素时为 172933；评测机标准库版本不同时可手动指定）
+     * @return vector< long long > 互不相同、顺序随机的键，均为 bucket_count 的倍数
+     *
+     * @note 最后一次扩容后所有键在同一条链上，之后每次插入 / 查找都是 O(count)
+     * @throws std::invalid_argument count * bucket_count > max_value 时
      */
-    class RANDOMGRAPH {
-        private:
-            struct Edge {
-                int u , v;
+    std::vector < long long > antiHashKeys( std::size_t count , long long max_value = 1000000000000000000LL ,
+                                            std::size_t bucket_count = 0 );
 
-                bool operator==( const Edge &other ) const {
-                    return u == other.u && v == other.v;
-                }
+    /**
+     * @brief 字符的分块接收器：流式生成函数每次交付一块字符（指针, 个数），指针只在回调期间有效
+     */
+    using CharChunkSink = std::function < void( const char * , std::size_t ) >;
 
-                bool operator<( const Edge &other ) const {
-                    return u < other.u || ( u == other.u && v < other.v );
-                }
-            };
+    // 字符串流式生成默认的分块大小（字符）
+    constexpr std::size_t CHAR_CHUNK_SIZE = std::size_t( 1 ) << 16;
 
-            /**
-             * @brief 计算节点最小边数
-             * @param n 节点数量
-             * @param connected 是否连通
-             * @param directional 图的有向性
-             * @return 节点最小边数
-             */
-            static int compute_min_edges( int n , bool connected , bool directional ) {
-                if ( !connected || n <= 1 ) return 0;
-                if ( directional ) return n; // 有向连通：需要成环，至少 n 条边
-                return n - 1; // 无向连通：树，至少 n-1 条边
-            }
+    /**
+     * @brief 多项式哈希参数：h(s) = Σ s[i]·base^(n-1-i) mod mod（即 h = h·base + s[i] 的写法）
+     * @note mod 为 0 表示 unsigned long long 自然溢出（模 2^64），此时 base 为 0 表示任意奇数底数
+     */
+    struct PolyHash {
+        unsigned long long base;
+        unsigned long long mod;
+    };
 
+    /**
+     * @brief 结构化字符串：卡 KMP / Z / 后缀结构的朴素实现以及多项式哈希
+     * @details 每种字符串都有返回 std::string 的版本与按块交给 CharChunkSink 的 stream_ 版本，
+     *          生成时间均为 O(n)，stream_ 版本的额外内存与 n 无关
+     */
+    class RANDOMSTRING {
+        public:
             /**
-             * @brief 计算节点最大边数
-             * @param n 节点数量
-             * @param repeated_edges 是否重边
-             * @param self_rings 是否自环
-             * @param directional 是否有向
-             * @return 节点最大边数
+             * @brief Fibonacci 串（a → ab, b → a 的不动点）的前 n 个字符："abaababaabaab..."
+             * @note 任意前缀的周期结构极多，border 链长度为 Θ(log n)，且含大量平方串（重复子串）
              */
-            static long long compute_max_edges( int n , bool repeated_edges , bool self_rings , bool directional ) {
-                if ( n <= 0 ) return 0;
-                if ( repeated_edges ) {
-                    // 允许重边时，设置一个实际上限
-                    return static_cast < long long >( n ) * n * 10;
-                }
-                long long base;
-                if ( directional ) {
-                    base = static_cast < long long >( n ) * ( n - 1 ); // 有向：n(n-1)
-                } else {
-                    base = static_cast < long long >( n ) * ( n - 1 ) / 2; // 无向：n(n-1)/2
-                }
-                if ( self_rings ) {
-                    base += n; // 加上 n 个自环
-                }
-                return base;
-            }
+            std::string fibonacci_word( std::size_t n , char a = 'a' , char b = 'b' );
+
+            void stream_fibonacci_word( std::size_t n , const CharChunkSink &sink , char a = 'a' , char b = 'b' ,
+                                        std::size_t chunk_size = CHAR_CHUNK_SIZE );
 
-        public:
             /**
-             * 随机生成图（默认无向连通图（无重边、无自环））{点,边} 校验生成
-             * @param n 期望的节点数 (必须 > 0)
-             * @param m 期望的边数 (必须 >= 0)
-             * @param connected 是否要求连通（无向图为连通，有向图为弱连通）
-             * @param repeated_edges 是否允许重边
-             * @param self_rings 是否允许自环
-             * @param directional 是否为有向图
-             * @param opt 接近度参数 ∈ (0, +∞)
-             *                        - opt → 0:   返回值可能在合法范围内随机偏移
-             *                        - opt → ∞:   返回值尽可能接近输入的 (n, m)
-             *                        - opt = 1:   中等程度的随机性
-             *                        - opt = 10:  较小的随机波动（推荐默认值）
-             * @throws std::invalid_argument 如果参数完全不可行
-             * @return std::pair<int, int> {点,边}
+             * @brief Thue-Morse 串的前 n 个字符：第 i 个字符为 popcount(i) 的奇偶性，"abbabaab..."
+             * @note 不含三次方串（xxx），长度 2^11 的 Thue-Morse 串与其取反对任意奇数底数在模 2^64 下哈希相同
              */
-            std::pair < int , int > valid_nm( int n , int m , bool connected = true , bool repeated_edges = false ,
-                                              bool self_rings = false ,
-                                              bool directional = false , double opt = 10.0 );
+            std::string thue_morse( std::size_t n , char a = 'a' , char b = 'b' );
+
+            void stream_thue_morse( std::size_t n , const CharChunkSink &sink , char a = 'a' , char b = 'b' ,
+                                    std::size_t chunk_size = CHAR_CHUNK_SIZE );
 
             /**
-             * @brief 生成随机图（默认无向连通图（无重边、无自环））
-             * @param n 节点数量
-             * @param m 边数
-             * @param connected 是否连通
-             * @param repeated_edges 是否允许重边
-             * @param self_rings 是否允许自环
-             * @param directional 是否为有向图
-             * @param base 节点偏移量，默认是 1
-             * @return vector< pair< int, int > > 边集数组
+             * @brief 周期串：随机生成长度为 period 的周期重复到 n 个字符，再在 breaks 个随机位置改成其他字符
+             * @param n 字符串长度
+             * @param period 周期长度 (>= 1)
+             * @param breaks 破坏位置数量 (<= n)，每个位置的字符一定与原字符不同
+             * @param chars 字符集（breaks > 0 时至少包含两种不同字符）
              *
-             * @note 节点编号从 1 开始，即 [1, n]
+             * @note breaks 很小时几乎处处匹配又在少数位置失配，卡朴素匹配与错误的失配回退
              */
-            std::vector < std::pair < int , int > > random_graph( int n , int m , bool connected = true ,
-                                                                  bool repeated_edges = false ,
-                                                                  bool self_rings = false ,
-                                                                  bool directional = false ,
-                                                                  int base = 1 );
+            std::string periodic_string( std::size_t n , std::size_t period , std::size_t breaks = 0 ,
+                                         const std::string &chars = "ab" );
+
+            void stream_periodic_string( std::size_t n , std::size_t period , const CharChunkSink &sink ,
+                                         std::size_t breaks = 0 , const std::string &chars = "ab" ,
+                                         std::size_t chunk_size = CHAR_CHUNK_SIZE );
 
             /**
-             * @brief 生成二分图
-             * @param n1 第一部分节点数
-             * @param n2 第二部分节点数
-             * @param m 边数
-             * @param base 节点偏移量，默认是 1
-             * @param directional 是否为有向图
-             * @return vector< pair< int, int > > 边集数组
-             *
-             * @note 节点编号从 1 开始，即 [1, n]
+             * @brief 低熵串：由若干段相同字符组成，段长服从均值为 mean_run 的几何分布，相邻段字符不同
+             * @param n 字符串长度
+             * @param mean_run 平均段长 (>= 1)，如 n 时大概率只有一两段，形如 "aaaa...abaaa"
+             * @param chars 字符集（至少包含两种不同字符，只有一种时退化为全同串）
              */
-            std::vector < std::pair < int , int > > random_binary_graph(
-                int n1 , int n2 , int m , bool directional = false , int base = 1 );
+            std::string low_entropy_string( std::size_t n , double mean_run = 1000.0 ,
+                                            const std::string &chars = "ab" );
+
+            void stream_low_entropy_string( std::size_t n , double mean_run , const CharChunkSink &sink ,
+                                            const std::string &chars = "ab" ,
+                                            std::size_t chunk_size = CHAR_CHUNK_SIZE );
 
             /**
-             * @brief 生成 DAG（有向无环图）
-             * @param n 节点数量
-             * @param m 边数
-             * @param base 节点偏移量，默认是 1
-             * @return vector< pair< int, int > > 边集数组
+             * @brief 构造长度均为 n、对 hashes 中每组参数哈希值都相同的两个不同字符串
+             * @param n 字符串长度（不小于碰撞块长度，多出的部分两串相同，为随机字符）
+             * @param hashes 哈希参数，依次处理，前一组的碰撞对作为后一组的两个"字符"：
+             *               模 2^64 且底数为奇数（或 0）时使用 Thue-Morse（块长 ×2048），
+             *               模 2^64 且底数为偶数时利用 base^64 ≡ 0，其余使用树形攻击（sort + 相邻差分）；
+             *               相邻的互素模数在乘积不超过 2^63 时先用 CRT 合并为一组
+             * @param a b 碰撞部分使用的两个字符，其余位置从 a b 中随机选取
+             * @return pair< string, string > 碰撞串对
              *
-             * @note 节点编号从 1 开始，即 [1, n]
+             * @note 碰撞对 h = h·base + s[i] 的写法成立；若哈希写成 Σ s[i]·base^i，对两个串分别 reverse 即可。
+             *       字符映射为 s[i] - 'a' + 1 等任意仿射映射时同样碰撞。常见单模数（1e9 级）块长约 2^9，
+             *       双模数（1e9 级）与模 2^61 - 1 约 2^12，模 2^64 与模素数同时卡时约 2^20
+             * @throws std::invalid_argument 模数为 1、a == b 或碰撞块长超过 n 时
              */
-            std::vector < std::pair < int , int > > random_dag_graph(
-                int n , int m , int base = 1 );
+            std::pair < std::string , std::string > anti_hash_strings( std::size_t n ,
+                                                                       const std::vector < PolyHash > &hashes ,
+                                                                       char a = 'a' , char b = 'b' );
     };
 
-    static RANDOMGRAPH RandomGraph;
+    [[maybe_unused]] static RANDOMSTRING RandomString;
 
     /**
      * @brief 快速幂
@@ -446,6 +1670,351 @@ namespace AMPLE_RAND {
      */
     std::ofstream openOutputFileStream( const std::string &str );
 
+    /**
+     * @brief 缓冲输出流：数据直接流式写入文件，内存占用固定为缓冲区大小
+     * @details 整数与浮点数使用 std::to_chars 格式化，直接写入内部缓冲区，缓冲区满时整块写入文件；
+     *          其余类型以及 iostream 操纵符（fixed / setprecision / setw / endl 等）转交内部的
+     *          std::ostringstream 格式化，因此原有的 `ins << ...` 写法无需修改
+     *
+     *          未打开文件时数据保存在内存中（缓冲区按需增长），可通过 view() / str() 读取
+     */
+    class OutputSink {
+        public:
+            // 默认缓冲区大小（1 MiB）
+            static constexpr std::size_t DEFAULT_CAPACITY = std::size_t( 1 ) << 20;
+
+            explicit OutputSink( std::size_t capacity = DEFAULT_CAPACITY );
+
+            ~OutputSink();
+
+            OutputSink( const OutputSink & ) = delete;
+
+            OutputSink &operator=( const OutputSink & ) = delete;
+
+            /**
+             * @brief 打开文件（关闭之前的文件并丢弃内存中的数据）
+             * @param path 文件路径
+             * @return 是否打开成功
+             */
+            bool open( const std::string &path );
+
+            /**
+             * @brief 写出剩余数据并关闭文件
+             * @return 本文件的所有写入是否都成功
+             */
+            bool close();
+
+            bool is_open() const {
+                return file != nullptr;
+            }
+
+            /**
+             * @brief 将缓冲区写入文件
+             */
+            void flush();
+
+            /**
+             * @brief 丢弃内存中尚未写出的数据
+             */
+            void clear() {
+                used = 0;
+            }
+
+            /**
+             * @brief 内存中尚未写出的数据（未打开文件时即全部数据）
+             */
+            std::string_view view() const {
+                return std::string_view( buffer.data() , used );
+            }
+
+            std::string str() const {
+                return std::string( buffer.data() , used );
+            }
+
+            OutputSink &put( char c ) {
+                *reserve( 1 ) = c;
+                ++used;
+                return *this;
+            }
+
+            OutputSink &write( const char *s , std::size_t n );
+
+            OutputSink &operator<<( std::ostream &( *manip )( std::ostream & ) );
+
+            OutputSink &operator<<( std::ios_base &( *manip )( std::ios_base & ) );
+
+            template < typename T > OutputSink &operator<<( const T &value ) {
+                using U = std::decay_t < T >;
+                if constexpr ( std::is_same_v < U , char > || std::is_same_v < U , signed char > ||
+                               std::is_same_v < U , unsigned char > ) {
+                    return put( static_cast < char >( value ) );
+                } else if constexpr ( std::is_integral_v < U > && !std::is_same_v < U , bool > ) {
+                    if ( !plainInteger ) return formatted( value );
+                    // 64 位整数最多 20 位数字加符号
+                    char *p = reserve( 24 );
+                    used += static_cast < std::size_t >( std::to_chars( p , p + 24 , value ).ptr - p );
+                    return *this;
+                } else if constexpr ( std::is_same_v < U , double > || std::is_same_v < U , float > ) {
+                    if ( floatMode < 0 ) return formatted( value );
+                    return writeFloating( static_cast < double >( value ) );
+                } else if constexpr ( std::is_convertible_v < const T & , std::string_view > ) {
+                    const std::string_view sv = value;
+                    return write( sv.data() , sv.size() );
+                } else {
+                    return formatted( value );
+                }
+            }
+
+        private:
+            std::FILE *file = nullptr;
+            std::vector < char > buffer;
+            std::size_t used = 0;
+            std::size_t capacity;
+            bool failed = false;
+            // 非 to_chars 路径的格式化器，同时保存 fixed / setprecision 等格式状态
+            std::ostringstream formatter;
+            // 当前格式状态下整数能否走 to_chars
+            bool plainInteger = true;
+            // 浮点格式：-1 走 formatter，否则为 std::chars_format 对应值
+            int floatMode = 0;
+
+            /**
+             * @brief 保证缓冲区至少还有 n 个字节可写
+             * @return 可写位置
+             */
+            char *reserve( std::size_t n ) {
+                if ( buffer.size() - used < n ) makeRoom( n );
+                return buffer.data() + used;
+            }
+
+            void makeRoom( std::size_t n );
+
+            OutputSink &writeFloating( double value );
+
+            // 根据 formatter 的格式状态更新 plainInteger / floatMode
+            void syncFormat();
+
+            template < typename T > OutputSink &formatted( const T &value ) {
+                formatter << value;
+                const std::string s = formatter.str();
+                formatter.str( std::string() );
+                syncFormat();
+                return write( s.data() , s.size() );
+            }
+    };
+
+    namespace detail {
+        /**
+         * @brief 批量序列化用的栈上缓冲区：用 std::to_chars 格式化，满时整块交给 out.write
+         * @tparam Out OutputSink 或 std::ostream
+         */
+        template < typename Out > class ChunkWriter {
+            public:
+                explicit ChunkWriter( Out &out ) : out( out ) {
+                }
+
+                ~ChunkWriter() {
+                    flush();
+                }
+
+                ChunkWriter( const ChunkWriter & ) = delete;
+
+                ChunkWriter &operator=( const ChunkWriter & ) = delete;
+
+                /**
+                 * @brief 写入一个数：整数按十进制，浮点数按最短可往返表示
+                 */
+                template < typename T > void value( T v ) {
+                    static_assert( std::is_arithmetic_v < T > && !std::is_same_v < T , bool > ,
+                                   "ChunkWriter::value 只支持整数与浮点数" );
+                    if ( SIZE - pos < 64 ) flush();
+                    pos = static_cast < std::size_t >( std::to_chars( buf + pos , buf + SIZE , v ).ptr - buf );
+                }
+
+                void text( std::string_view s ) {
+                    if ( s.size() == 1 && pos < SIZE ) {
+                        buf[pos++] = s[0];
+                        return;
+                    }
+                    if ( SIZE - pos < s.size() ) {
+                        flush();
+                        if ( s.size() > SIZE ) {
+                            out.write( s.data() , static_cast < std::streamsize >( s.size() ) );
+                            return;
+                        }
+                    }
+                    std::memcpy( buf + pos , s.data() , s.size() );
+                    pos += s.size();
+                }
+
+                void flush() {
+                    if ( pos == 0 ) return;
+                    out.write( buf , static_cast < std::streamsize >( pos ) );
+                    pos = 0;
+                }
+
+            private:
+                static constexpr std::size_t SIZE = std::size_t( 1 ) << 14;
+                Out &out;
+                char buf[SIZE];
+                std::size_t pos = 0;
+        };
+    }
+
+    /**
+     * @brief 输出整数/浮点数数组
+     * @param out 输出目标（OutputSink 或 std::ostream）
+     * @param a 数组（任意可遍历容器）
+     * @param sep 元素之间的分隔符
+     * @param end 末尾追加的内容
+     *
+     * @note 固定按十进制输出，不受 out 上 hex / setprecision 等格式状态影响；浮点数使用最短可往返表示
+     */
+    template < typename Out , typename Container >
+    void writeArray( Out &out , const Container &a , std::string_view sep = " " , std::string_view end = "\n" ) {
+        detail::ChunkWriter < Out > w( out );
+        bool first = true;
+        for ( const auto &x : a ) {
+            if ( !first ) w.text( sep );
+            first = false;
+            w.value( x );
+        }
+        w.text( end );
+    }
+
+    /**
+     * @brief 输出边集，每条边一行 "u v"
+     * @param out 输出目标（OutputSink 或 std::ostream）
+     * @param edges 边集（RandomTree / RandomGraph 的返回值）
+     * @param sep 同一条边两端点之间的分隔符
+     * @param end 每条边之后的分隔符
+     */
+    template < typename Out , typename U , typename V >
+    void writeEdges( Out &out , const std::pair < U , V > *edges , std::size_t count ,
+                     std::string_view sep = " " , std::string_view end = "\n" ) {
+        detail::ChunkWriter < Out > w( out );
+        for ( std::size_t i = 0 ; i < count ; ++i ) {
+            w.value( edges[i].first );
+            w.text( sep );
+            w.value( edges[i].second );
+            w.text( end );
+        }
+    }
+
+    template < typename Out , typename U , typename V >
+    void writeEdges( Out &out , const std::vector < std::pair < U , V > > &edges ,
+                     std::string_view sep = " " , std::string_view end = "\n" ) {
+        writeEdges( out , edges.data() , edges.size() , sep , end );
+    }
+
+    /**
+     * @brief 生成把边块写入 out 的 EdgeChunkSink，配合 stream_tree / stream_graph 使用
+     * @param out 输出目标（OutputSink 或 std::ostream），需在流式生成期间保持有效
+     */
+    template < typename Out >
+    EdgeChunkSink edgeWriter( Out &out , std::string sep = " " , std::string end = "\n" ) {
+        return [&out , sep = std::move( sep ) , end = std::move( end )]( const std::pair < int , int > *edges ,
+                                                                         std::size_t count ) {
+            writeEdges( out , edges , count , sep , end );
+        };
+    }
+
+    /**
+     * @brief 生成把字符块写入 out 的 CharChunkSink，配合 RandomString.stream_* 使用
+     * @param out 输出目标（OutputSink 或 std::ostream），需在流式生成期间保持有效
+     */
+    template < typename Out > CharChunkSink stringWriter( Out &out ) {
+        return [&out]( const char *s , std::size_t count ) {
+            out.write( s , static_cast < std::streamsize >( count ) );
+        };
+    }
+
+    /**
+     * @brief 生成把整数块写入 out 的 ValueChunkSink，配合 streamDistinct / streamSortedSample 使用
+     * @param out 输出目标（OutputSink 或 std::ostream），需在流式生成期间保持有效
+     * @param sep 相邻两个数之间的分隔符（跨块时同样只在数之间出现）
+     */
+    template < typename Out > ValueChunkSink valueWriter( Out &out , std::string sep = " " ) {
+        return [&out , sep = std::move( sep ) , first = true]( const long long *values , std::size_t count ) mutable {
+            detail::ChunkWriter < Out > w( out );
+            for ( std::size_t i = 0 ; i < count ; ++i ) {
+                if ( !first ) w.text( sep );
+                first = false;
+                w.value( values[i] );
+            }
+        };
+    }
+
+    /**
+     * @brief 输出带权边集，每条边一行 "u v w"
+     * @param out 输出目标（OutputSink 或 std::ostream）
+     * @param edges 边集
+     * @param weights 边权，weights[i] 对应 edges[i]
+     * @param sep 同一行内的分隔符
+     * @param end 每条边之后的分隔符
+     */
+    template < typename Out , typename U , typename V , typename Weights >
+    void writeWeightedEdges( Out &out , const std::vector < std::pair < U , V > > &edges , const Weights &weights ,
+                             std::string_view sep = " " , std::string_view end = "\n" ) {
+        if ( static_cast < std::size_t >( std::size( weights ) ) != edges.size() ) {
+            throw std::invalid_argument( "weights size must equal edges size" );
+        }
+        detail::ChunkWriter < Out > w( out );
+        auto it = std::begin( weights );
+        for ( const auto &[u , v] : edges ) {
+            w.value( u );
+            w.text( sep );
+            w.value( v );
+            w.text( sep );
+            w.value( *it );
+            w.text( end );
+            ++it;
+        }
+    }
+
+    /**
+     * @brief 输出带权边集（random_weighted_* 的返回值），每条边一行 "u v w"
+     */
+    template < typename Out >
+    void writeWeightedEdges( Out &out , const WeightedEdges &edges , std::string_view sep = " " ,
+                             std::string_view end = "\n" ) {
+        detail::ChunkWriter < Out > w( out );
+        for ( std::size_t i = 0 ; i < edges.size() ; ++i ) {
+            w.value( edges.u[i] );
+            w.text( sep );
+            w.value( edges.v[i] );
+            w.text( sep );
+            w.value( edges.w[i] );
+            w.text( end );
+        }
+    }
+
+    /**
+     * @brief 输出父亲数组（RandomTree.random_tree_parent 的返回值）
+     * @param out 输出目标（OutputSink 或 std::ostream）
+     * @param parent 父亲数组，根节点为 -1
+     * @param skipRoot 为 true 时跳过根节点；否则根节点输出 rootValue
+     * @param sep 元素之间的分隔符
+     * @param end 末尾追加的内容
+     * @param rootValue 根节点的输出值，默认 0
+     *
+     * @note base = 0 时 0 也是合法节点编号，应传入 -1 等不在 [base, base + n) 中的 rootValue，
+     *       否则根节点与节点 0 的父亲无法区分
+     */
+    template < typename Out >
+    void writeParents( Out &out , const std::vector < int > &parent , bool skipRoot = false ,
+                       std::string_view sep = " " , std::string_view end = "\n" , int rootValue = 0 ) {
+        detail::ChunkWriter < Out > w( out );
+        bool first = true;
+        for ( int p : parent ) {
+            if ( p == -1 && skipRoot ) continue;
+            if ( !first ) w.text( sep );
+            first = false;
+            w.value( p == -1 ? rootValue : p );
+        }
+        w.text( end );
+    }
+
     /**
     * @brief 高精度模板类 BigIntTiny
     */
@@ -960,6 +2529,9 @@ namespace AMPLE_RAND {
      * @param multiple 多组数据规模上限
      * @param strategy 递增策略
      * @return 是否生成成功
+     *
+     * @note 文件 index 的第 k 组数据以 deriveSeed(index, k) 重新播种，
+     *       因此单独重新生成某个文件时结果与整套生成一致
      */
     bool batchGenerateFiles( int startIndex , int endIndex ,
                              std::function < void( long long , long long , double ) > solve ,
@@ -968,24 +2540,98 @@ namespace AMPLE_RAND {
                              std::stringstream &ous ,
                              int multiple = 1 ,
                              GradientStrategy strategy = GradientStrategy::SIGMOID );
+
+    /**
+     * @brief 多文件多组数据生成（流式输出版本）
+     * @details 与 stringstream 版本参数含义相同，但 ins/ous 在生成每个文件前直接打开对应的 .in/.out 文件，
+     *          solve 写入的数据经固定大小的缓冲区流式写入磁盘，不在内存中保存整个文件
+     */
+    bool batchGenerateFiles( int startIndex , int endIndex ,
+                             std::function < void( long long , long long , double ) > solve ,
+                             long long Limit ,
+                             OutputSink &ins ,
+                             OutputSink &ous ,
+                             int multiple = 1 ,
+                             GradientStrategy strategy = GradientStrategy::SIGMOID );
+
+    /**
+     * @brief 多文件多组数据并行生成
+     * @details 每个文件编号由一个工作线程独立生成，线程拥有自己的 rng_64 与 ins/ous 输出流，
+     *          文件 index 的随机数引擎以 deriveSeedFrom(seed, index, k) 播种（与串行版本相同），
+     *          因此输出与线程数无关，逐字节一致
+     * @param startIndex 文件起始编号
+     * @param endIndex 文件结束编号
+     * @param solve 数据生成逻辑代码（通过参数中的 ins/ous 写入数据，不能使用全局流；
+     *              ins/ous 已打开对应文件，数据流式写入磁盘）
+     * @param Limit 数据规模上限
+     * @param multiple 多组数据规模上限
+     * @param strategy 递增策略
+     * @param threads 工作线程数（0 表示使用硬件并发数）
+     * @param seed 主种子（默认为当前主种子）
+     * @return 是否生成成功
+     */
+    bool batchGenerateFilesParallel( int startIndex , int endIndex ,
+                                     std::function < void( long long , long long , double ,
+                                                           OutputSink & , OutputSink & ) > solve ,
+                                     long long Limit ,
+                                     int multiple = 1 ,
+                                     GradientStrategy strategy = GradientStrategy::SIGMOID ,
+                                     unsigned threads = 0 ,
+                                     unsigned long long seed = getSeed() );
 }
 
+using AMPLE_RAND::RandomEngine;
+using AMPLE_RAND::setSeed;
+using AMPLE_RAND::getSeed;
+using AMPLE_RAND::deriveSeed;
+using AMPLE_RAND::deriveSeedFrom;
+using AMPLE_RAND::printSeed;
 using AMPLE_RAND::random;
 using AMPLE_RAND::randomDouble;
+using AMPLE_RAND::randomFill;
+using AMPLE_RAND::randomArray;
+using AMPLE_RAND::randomDoubleFill;
+using AMPLE_RAND::randomDoubleArray;
 using AMPLE_RAND::randomString;
+using AMPLE_RAND::Alphabet;
 using AMPLE_RAND::RandomBasic;
+using AMPLE_RAND::setShuffleThreads;
+using AMPLE_RAND::getShuffleThreads;
+using AMPLE_RAND::ValueChunkSink;
+using AMPLE_RAND::randomPermutation;
+using AMPLE_RAND::randomDistinct;
+using AMPLE_RAND::streamDistinct;
+using AMPLE_RAND::randomSortedSample;
+using AMPLE_RAND::streamSortedSample;
+using AMPLE_RAND::randomComposition;
 using AMPLE_RAND::RandomTree;
 using AMPLE_RAND::RandomGraph;
 using AMPLE_RAND::QuickPow;
 using AMPLE_RAND::exgcd;
 using AMPLE_RAND::openInputFileStream;
 using AMPLE_RAND::openOutputFileStream;
+using AMPLE_RAND::OutputSink;
+using AMPLE_RAND::writeArray;
+using AMPLE_RAND::writeEdges;
+using AMPLE_RAND::edgeWriter;
+using AMPLE_RAND::EdgeChunkSink;
+using AMPLE_RAND::writeWeightedEdges;
+using AMPLE_RAND::WeightedEdges;
+using AMPLE_RAND::WeightDistribution;
+using AMPLE_RAND::antiHashKeys;
+using AMPLE_RAND::CharChunkSink;
+using AMPLE_RAND::PolyHash;
+using AMPLE_RAND::RandomString;
+using AMPLE_RAND::stringWriter;
+using AMPLE_RAND::valueWriter;
+using AMPLE_RAND::writeParents;
 using AMPLE_RAND::BigIntTiny;
 using AMPLE_RAND::MemUtil;
 using AMPLE_RAND::GradientStrategy;
 using AMPLE_RAND::getGradientOpt;
 using AMPLE_RAND::getAllGradientOpts;
 using AMPLE_RAND::batchGenerateFiles;
+using AMPLE_RAND::batchGenerateFilesParallel;
 
 // 数据文件地址
 const std::string dataFilePath = "D:\\Desktop\\data\\";
@@ -0,0 +1,229 @@
+/**
+    @Description: 随机数引擎与生成函数性能测试
+
+    引擎在编译期选择，比较不同引擎时分别编译运行：
+        g++ -std=c++17 -O2 -o bench benchmark.cpp DataGenerator.cpp
+        g++ -std=c++17 -O2 -DAMPLE_RAND_ENGINE=AMPLE_RAND::Xoshiro256StarStar -o bench benchmark.cpp DataGenerator.cpp
+        g++ -std=c++17 -O2 -DAMPLE_RAND_ENGINE=AMPLE_RAND::Pcg64 -o bench benchmark.cpp DataGenerator.cpp
+        g++ -std=c++17 -O2 -DAMPLE_RAND_ENGINE=AMPLE_RAND::SplitMix64 -o bench benchmark.cpp DataGenerator.cpp
+*/
+
+#include "DataGenerator.h"
+using namespace std ;
+
+// 防止结果被编译器优化掉
+volatile unsigned long long sink;
+
+/**
+ * @brief 运行 f 并输出耗时
+ * @param title 测试名称
+ * @param count 操作次数
+ * @param f 测试函数
+ */
+template < typename Func > void measure( const string &title , long long count , Func &&f ) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration < double , milli >( end - start ).count();
+    printf( "%-40s %10.2f ms  %8.2f ns/op\n" , title.c_str() , ms , ms * 1e6 / max( 1LL , count ) );
+}
+
+template < typename Engine > const char *engineName() {
+    if constexpr ( is_same_v < Engine , mt19937_64 > ) return "mt19937_64";
+    else return Engine::name;
+}
+
+/**
+ * @brief 引擎原始吞吐量（直接调用 operator()）
+ */
+template < typename Engine > void benchEngine( long long count ) {
+    Engine engine( 20240711 );
+    measure( string( "engine " ) + engineName < Engine >() , count , [&] {
+        unsigned long long acc = 0;
+        for ( long long i = 0 ; i < count ; ++i ) acc += engine();
+        sink = acc;
+    } );
+}
+
+/**
+ * @brief 从 1 号点出发的 SPFA（队列 Bellman-Ford），返回成功松弛的次数
+ */
+long long spfaRelaxations( int n , const WeightedEdges &edges , bool directional ) {
+    vector < vector < pair < int , long long > > > g( n + 1 );
+    for ( size_t i = 0 ; i < edges.size() ; ++i ) {
+        g[edges.u[i]].emplace_back( edges.v[i] , edges.w[i] );
+        if ( !directional ) g[edges.v[i]].emplace_back( edges.u[i] , edges.w[i] );
+    }
+    vector < long long > dist( n + 1 , LLONG_MAX );
+    vector < char > in_queue( n + 1 , 0 );
+    deque < int > q;
+    dist[1] = 0;
+    q.push_back( 1 );
+    long long relaxations = 0;
+    while ( !q.empty() ) {
+        const int x = q.front();
+        q.pop_front();
+        in_queue[x] = 0;
+        for ( auto [y , w] : g[x] ) {
+            if ( dist[x] + w < dist[y] ) {
+                dist[y] = dist[x] + w;
+                ++relaxations;
+                if ( !in_queue[y] ) {
+                    in_queue[y] = 1;
+                    q.push_back( y );
+                }
+            }
+        }
+    }
+    return relaxations;
+}
+
+/**
+ * @brief 比较 uniform 与 adversarial 边权下 SPFA 的松弛次数（同一种子，图结构相同）
+ */
+void compareSpfa( int n , long long m , bool directional ) {
+    setSeed( 20240711 );
+    const auto uniform = RandomGraph.random_weighted_graph( n , m , WeightDistribution::uniform( 1 , 1000000000 ) ,
+                                                            true , false , false , directional );
+    setSeed( 20240711 );
+    const auto adversarial = RandomGraph.random_weighted_graph( n , m ,
+                                                                WeightDistribution::adversarial( 1 , 1000000000 ) ,
+                                                                true , false , false , directional );
+    const long long a = spfaRelaxations( n , uniform , directional );
+    const long long b = spfaRelaxations( n , adversarial , directional );
+    printf( "%-40s %12lld -> %12lld  (x%.2f)%s\n" ,
+            ( string( "SPFA relaxations, " ) + ( directional ? "directed" : "undirected" ) ).c_str() ,
+            a , b , static_cast < double >( b ) / max( 1LL , a ) , b > a ? "" : "  [adversarial 未生效]" );
+}
+
+signed main() {
+    setSeed( 20240711 );
+    const long long N = 10000000;
+    const int GRAPH_N = 200000;
+
+    printf( "==================== 引擎原始吞吐量 ====================\n" );
+    benchEngine < mt19937_64 >( N );
+    benchEngine < AMPLE_RAND::Xoshiro256StarStar >( N );
+    benchEngine < AMPLE_RAND::Pcg64 >( N );
+    benchEngine < AMPLE_RAND::SplitMix64 >( N );
+
+    printf( "\n============ 生成函数（当前引擎：%s）============\n" , engineName < RandomEngine >() );
+    measure( "random(1, 1e9)" , N , [&] {
+        unsigned long long acc = 0;
+        for ( long long i = 0 ; i < N ; ++i ) acc += random( 1 , 1000000000 );
+        sink = acc;
+    } );
+    measure( "random(1, 1e9, 2.5)" , N , [&] {
+        unsigned long long acc = 0;
+        for ( long long i = 0 ; i < N ; ++i ) acc += random( 1 , 1000000000 , 2.5 );
+        sink = acc;
+    } );
+    measure( "randomDouble(0, 1)" , N , [&] {
+        double acc = 0;
+        for ( long long i = 0 ; i < N ; ++i ) acc += randomDouble( 0 , 1 );
+        sink = static_cast < unsigned long long >( acc );
+    } );
+    measure( "randomDouble(0, 1, 0.4)" , N , [&] {
+        double acc = 0;
+        for ( long long i = 0 ; i < N ; ++i ) acc += randomDouble( 0 , 1 , 0.4 );
+        sink = static_cast < unsigned long long >( acc );
+    } );
+    measure( "randomArray(1e7, 1, 1e9)" , N , [&] {
+        sink = randomArray( N , 1 , 1000000000 ).back();
+    } );
+    measure( "randomArray(1e7, 1, 1e9, 2.5)" , N , [&] {
+        sink = randomArray( N , 1 , 1000000000 , 2.5 ).back();
+    } );
+    measure( "randomArray(1e7, 1, 1e9, 0.5) [sqrt]" , N , [&] {
+        sink = randomArray( N , 1 , 1000000000 , 0.5 ).back();
+    } );
+    measure( "randomDoubleArray(1e7, 0, 1, 0.4)" , N , [&] {
+        sink = static_cast < unsigned long long >( randomDoubleArray( N , 0 , 1 , 0.4 ).back() );
+    } );
+    measure( "randomString(1e7, lowercase)" , N , [&] {
+        sink = randomString( N , charLowerCase ).size();
+    } );
+    {
+        const Alphabet lower( charLowerCase );
+        const Alphabet skewed( "ACGT" , { 0.4 , 0.3 , 0.2 , 0.1 } );
+        string buffer( N , '\0' );
+        measure( "Alphabet(lowercase).fill(1e7)" , N , [&] {
+            lower.fill( buffer.data() , buffer.size() );
+            sink = static_cast < unsigned char >( buffer.back() );
+        } );
+        measure( "Alphabet(ACGT, weighted).fill(1e7)" , N , [&] {
+            skewed.fill( buffer.data() , buffer.size() );
+            sink = static_cast < unsigned char >( buffer.back() );
+        } );
+    }
+    measure( "RandomString.fibonacci_word(1e7)" , N , [&] {
+        sink = RandomString.fibonacci_word( N ).size();
+    } );
+    measure( "RandomString.anti_hash_strings(1e6, 2 mods)" , 1 , [&] {
+        sink = RandomString.anti_hash_strings( 1000000 , { { 131 , 1000000007 } , { 137 , 998244353 } } ).first.size();
+    } );
+    measure( "RandomBasic.shuffle(1e7)" , N , [&] {
+        vector < int > perm( N );
+        iota( perm.begin() , perm.end() , 0 );
+        RandomBasic.shuffle( perm );
+        sink = perm.back();
+    } );
+    measure( "RandomBasic.shuffle(2e7) [parallel]" , 2 * N , [&] {
+        vector < int > perm( 2 * N );
+        iota( perm.begin() , perm.end() , 0 );
+        RandomBasic.shuffle( perm );
+        sink = perm.back();
+    } );
+    measure( "randomPermutation(1e7)" , N , [&] {
+        sink = randomPermutation( N ).back();
+    } );
+    measure( "randomDistinct(1e6, 1, 1e18)" , N / 10 , [&] {
+        sink = randomDistinct( N / 10 , 1 , 1000000000000000000LL ).back();
+    } );
+    measure( "randomSortedSample(1e6, 1, 1e15)" , N / 10 , [&] {
+        sink = randomSortedSample( N / 10 , 1 , 1000000000000000LL ).back();
+    } );
+    measure( "randomComposition(1e9, 1e6)" , N / 10 , [&] {
+        sink = randomComposition( 1000000000 , N / 10 ).back();
+    } );
+    measure( "stringstream << 1e7 ints" , N , [&] {
+        stringstream ss;
+        for ( long long i = 0 ; i < N ; ++i ) ss << i * 2654435761LL % 1000000007 << ' ';
+        sink = ss.str().size();
+    } );
+    measure( "OutputSink << 1e7 ints" , N , [&] {
+        OutputSink out;
+        for ( long long i = 0 ; i < N ; ++i ) out << i * 2654435761LL % 1000000007 << ' ';
+        sink = out.view().size();
+    } );
+    {
+        auto edges = RandomGraph.random_graph( GRAPH_N , 1000000 );
+        measure( "ostream << 1e6 edges" , 1000000 , [&] {
+            ostringstream out;
+            for ( auto [u , v] : edges ) out << u << ' ' << v << '\n';
+            sink = out.str().size();
+        } );
+        measure( "writeEdges(OutputSink, 1e6 edges)" , 1000000 , [&] {
+            OutputSink out;
+            writeEdges( out , edges );
+            sink = out.view().size();
+        } );
+    }
+    measure( "random_tree(2e5)" , GRAPH_N , [&] {
+        sink = RandomTree.random_tree( GRAPH_N ).size();
+    } );
+    measure( "random_binary_tree(2e4)" , GRAPH_N / 10 , [&] {
+        sink = RandomTree.random_binary_tree( GRAPH_N / 10 ).size();
+    } );
+    measure( "random_graph(2e5, 1e6)" , 1000000 , [&] {
+        sink = RandomGraph.random_graph( GRAPH_N , 1000000 ).size();
+    } );
+    measure( "random_dag_graph(2e5, 1e6)" , 1000000 , [&] {
+        sink = RandomGraph.random_dag_graph( GRAPH_N , 1000000 ).size();
+    } );
+
+    printf( "\n========= 边权分布：uniform -> adversarial 的 SPFA 松弛次数 =========\n" );
+    compareSpfa( 100000 , 300000 , false );
+    compareSpfa( 20000 , 60000 , true );
+    return 0;
+}
@@ -2,10 +2,10 @@
 using namespace std ;
 #define int long long
 
-// 输入数据存储字符串流（类比 cin）
-stringstream ins;
-// 输出数据存储字符串流（类比 cout）
-stringstream ous;
+// 输入数据输出流，直接写入 .in 文件（用法同 cout）
+OutputSink ins;
+// 输出数据输出流，直接写入 .out 文件（用法同 cout）
+OutputSink ous;
 
 /**
  * @brief 数据生成逻辑代码